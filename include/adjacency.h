@@ -0,0 +1,135 @@
+/**
+* @file   adjacency.h
+* @author Laura Melas <laura.melas@mail.polimi.it>
+* @date   2017
+*
+* This file is part of project "AMG Methods".
+*
+* @brief AMG methods for conforming and discontinuous Galerkin finite element discretizations of the Poisson problem.
+*
+*/
+
+#ifndef ADJACENCY_H_INCLUDED
+#define ADJACENCY_H_INCLUDED
+
+#include "arena.h"
+
+/** @class adjacency
+* @brief This class stores a family of sets of points (one for each point) in two pooled arrays:
+* row pointers and elements. Sets are built in order by appending their elements and closing them, each set is sorted when closed.
+*
+*/
+
+class adjacency
+{
+public:
+
+/**
+* @brief Constructor (defaulted)
+*
+*/
+
+adjacency()=default;
+
+/**
+* @brief Constructor
+* @param[in] n: number of sets to be built
+* @param[in] nnz: expected total number of elements (memory is reserved)
+* @param[in] pool: arena providing the memory of the sets (nullptr for the general-purpose allocator)
+*
+*/
+
+adjacency(const int& n, const int& nnz=0, arena* pool=nullptr);
+
+/**
+* @brief Destructor (defaulted)
+*
+*/
+
+~adjacency(){}
+
+/**
+* @brief Append an element to the set being built
+* @param[in] j: element
+*
+*/
+
+inline void append(const int& j)
+{
+_ind.push_back(j);
+}
+
+/**
+* @brief Close the set being built (it is sorted) and start the next one
+*
+*/
+
+void close_row();
+
+/**
+* @brief Number of closed sets
+*
+*/
+
+inline int size() const
+{
+return _ptr.size()-1;
+}
+
+/**
+* @brief Position of the first element of set i
+* @param[in] i: set
+*
+*/
+
+inline int row_begin(const int& i) const
+{
+return _ptr[i];
+}
+
+/**
+* @brief One past the position of the last element of set i
+* @param[in] i: set
+*
+*/
+
+inline int row_end(const int& i) const
+{
+return _ptr[i+1];
+}
+
+/**
+* @brief Element in a given position
+* @param[in] k: position of the element
+*
+*/
+
+inline int col(const int& k) const
+{
+return _ind[k];
+}
+
+/**
+* @brief Cardinality of set i
+* @param[in] i: set
+*
+*/
+
+inline int cardinality(const int& i) const
+{
+return _ptr[i+1]-_ptr[i];
+}
+
+/**
+* @brief Memory allocated by the sets, in bytes
+*
+*/
+
+size_t bytes() const;
+
+private:
+avector<int> _ptr=avector<int>(1,0); /**< @brief pointers of the sets: set i is _ind[_ptr[i]],...,_ind[_ptr[i+1]-1] */
+avector<int> _ind; /**< @brief elements of all sets */
+};
+
+#endif // ADJACENCY_H_INCLUDED
@@ -0,0 +1,181 @@
+/**
+* @file   arena.h
+* @author Laura Melas <laura.melas@mail.polimi.it>
+* @date   2017
+*
+* This file is part of project "AMG Methods".
+*
+* @brief AMG methods for conforming and discontinuous Galerkin finite element discretizations of the Poisson problem.
+*
+*/
+
+#ifndef ARENA_H_INCLUDED
+#define ARENA_H_INCLUDED
+
+#include "common.h"
+
+/** @class arena
+* @brief This class defines a bump allocator: memory is taken in order from large blocks and it is given back all at once by reset.
+* Single deallocations are ignored. After a reset the blocks are merged in a single block, so that the next use of the arena
+* (e.g. the next level of setup, which is smaller) does not call the general-purpose allocator at all.
+* Allocation is thread-safe.
+*
+*/
+
+class arena
+{
+public:
+
+/**
+* @brief Constructor (defaulted)
+*
+*/
+
+arena()=default;
+
+/**
+* @brief Copy constructor: the memory of an arena is never shared, the copy is empty
+*
+*/
+
+arena(const arena&) {}
+
+/**
+* @brief Assignment: the memory of an arena is never shared, the assigned arena keeps its own memory
+*
+*/
+
+arena& operator=(const arena&)
+{
+return *this;
+}
+
+/**
+* @brief Destructor
+*
+*/
+
+~arena();
+
+/**
+* @brief Allocation of a memory block aligned to 64 bytes, safe in parallel regions (bad_alloc is thrown after leaving the critical section)
+* @param[in] bytes: size of the block
+*
+*/
+
+void* allocate(const size_t& bytes);
+
+/**
+* @brief Release of all allocations: memory is kept for the next allocations
+*
+*/
+
+void reset();
+
+/**
+* @brief Release of all allocations and of all memory of the arena
+*
+*/
+
+void release();
+
+/**
+* @brief Memory reserved by the arena, in bytes
+*
+*/
+
+size_t capacity() const;
+
+private:
+vector<char*> _block; /**< @brief memory blocks, the last one is the current block */
+vector<size_t> _size; /**< @brief size of memory blocks */
+size_t _used=0; /**< @brief bytes used in the current block */
+};
+
+/** @class arena_allocator
+* @brief Allocator for standard containers taking memory from an arena (from the general-purpose allocator if no arena is given).
+* Containers sharing an arena must not outlive its reset.
+*
+*/
+
+template<class T>
+class arena_allocator
+{
+public:
+typedef T value_type; /**< @brief type of allocated elements */
+typedef true_type propagate_on_container_copy_assignment; /**< @brief the arena follows the content of containers */
+typedef true_type propagate_on_container_move_assignment; /**< @brief the arena follows the content of containers */
+typedef true_type propagate_on_container_swap; /**< @brief the arena follows the content of containers */
+
+/**
+* @brief Constructor
+* @param[in] pool: arena (nullptr for the general-purpose allocator)
+*
+*/
+
+arena_allocator(arena* pool=nullptr) : _pool(pool) {}
+
+/**
+* @brief Conversion constructor
+* @param[in] a: allocator of another type sharing the arena
+*
+*/
+
+template<class U>
+arena_allocator(const arena_allocator<U>& a) : _pool(a.pool()) {}
+
+/**
+* @brief Allocation of n elements
+* @param[in] n: number of elements
+*
+*/
+
+inline T* allocate(const size_t& n)
+{
+if(_pool)
+	return static_cast<T*>(_pool->allocate(n*sizeof(T)));
+return static_cast<T*>(::operator new(n*sizeof(T)));
+}
+
+/**
+* @brief Deallocation (ignored for an arena)
+* @param[in] p: memory to be released
+*
+*/
+
+inline void deallocate(T* p, const size_t&)
+{
+if(!_pool)
+	::operator delete(p);
+}
+
+/**
+* @brief Reading the arena
+*
+*/
+
+inline arena* pool() const
+{
+return _pool;
+}
+
+private:
+arena* _pool; /**< @brief arena (nullptr for the general-purpose allocator) */
+};
+
+template<class T, class U>
+inline bool operator==(const arena_allocator<T>& a, const arena_allocator<U>& b)
+{
+return a.pool()==b.pool();
+}
+
+template<class T, class U>
+inline bool operator!=(const arena_allocator<T>& a, const arena_allocator<U>& b)
+{
+return a.pool()!=b.pool();
+}
+
+template<class T>
+using avector=vector<T,arena_allocator<T> >; /**< @brief Typedef for vectors taking memory from an arena. */
+
+#endif // ARENA_H_INCLUDED
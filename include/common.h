@@ -15,19 +15,25 @@
 #include <Eigen/Sparse>
 #include <Eigen/SparseCore>
 #include <Eigen/IterativeLinearSolvers>
+#include <Eigen/Eigenvalues>
 #include <unsupported/Eigen/SparseExtra>
 #include <iostream>
 #include <fstream>
 #include "stdlib.h"
 #include <vector>
 #include <algorithm> 
+#include <numeric>
 #include <iterator>
+#include <queue>
 #include <cmath> 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace Eigen;
 using namespace std;
 using Real=double; /**< @brief Typedef for real numbers. */
-typedef SparseMatrix<Real> SpMat; /**< @brief Typedef for sparse real-valued matrices. */
+typedef SparseMatrix<Real,RowMajor> SpMat; /**< @brief Typedef for sparse real-valued matrices, stored row-wise (CSR) so that row traversals cost O(nnz of the row). */
 typedef SparseVector<Real> SpVec; /**< @brief Typedef for sparse real-valued vectors. */
 typedef SparseVector<int> SpCount; /**< @brief Typedef for sparse int-valued vectors. */
 using Vec=Matrix<Real,Dynamic,1>;/**< @brief Typedef for real-valued vectors. */ 
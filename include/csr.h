@@ -0,0 +1,316 @@
+/**
+* @file   csr.h
+* @author Laura Melas <laura.melas@mail.polimi.it>
+* @date   2017
+*
+* This file is part of project "AMG Methods".
+*
+* @brief AMG methods for conforming and discontinuous Galerkin finite element discretizations of the Poisson problem.
+*
+*/
+
+#ifndef CSR_H_INCLUDED
+#define CSR_H_INCLUDED
+
+#include "common.h"
+
+/** @class cache_allocator
+* @brief Allocator for standard containers returning memory aligned to 64 bytes (a cache line, the widest SIMD register).
+*
+*/
+
+template<class T>
+class cache_allocator
+{
+public:
+typedef T value_type; /**< @brief type of allocated elements */
+
+/**
+* @brief Constructor (defaulted)
+*
+*/
+
+cache_allocator()=default;
+
+/**
+* @brief Conversion constructor
+*
+*/
+
+template<class U>
+cache_allocator(const cache_allocator<U>&) {}
+
+/**
+* @brief Allocation of n elements
+* @param[in] n: number of elements
+*
+*/
+
+inline T* allocate(const size_t& n)
+{
+void* p(nullptr);
+if(posix_memalign(&p,64,max(n*sizeof(T),size_t(1)))!=0)
+	throw bad_alloc();
+return static_cast<T*>(p);
+}
+
+/**
+* @brief Deallocation
+* @param[in] p: memory to be released
+*
+*/
+
+inline void deallocate(T* p, const size_t&)
+{
+free(p);
+}
+};
+
+template<class T, class U>
+inline bool operator==(const cache_allocator<T>&, const cache_allocator<U>&)
+{
+return 1;
+}
+
+template<class T, class U>
+inline bool operator!=(const cache_allocator<T>&, const cache_allocator<U>&)
+{
+return 0;
+}
+
+/** @class csr
+* @brief This class defines a sparse matrix in compressed row storage: row pointers, 32-bit column indices sorted within each row
+* and values, all aligned to 64 bytes. There is no uncompressed mode and no spare capacity, so the memory streamed by a product
+* is exactly (rows+1+nnz)*4+nnz*8 bytes. Accessors have the names of Eigen's compressed storage, so that kernels written on raw
+* arrays accept both types; eigen() gives a view of the matrix as an Eigen expression without copies.
+* A symmetric matrix can be reduced to its upper triangle (half storage): products and Gauss-Seidel sweeps then read each
+* off-diagonal entry once for both of its positions.
+*
+*/
+
+class csr
+{
+public:
+
+/**
+* @brief Constructor (defaulted)
+*
+*/
+
+csr()=default;
+
+/**
+* @brief Constructor of an empty matrix
+* @param[in] rows: number of rows
+* @param[in] cols: number of columns
+*
+*/
+
+csr(const int& rows, const int& cols);
+
+/**
+* @brief Constructor: copy of an Eigen matrix, compressed or not
+* @param[in] A: input matrix
+*
+*/
+
+explicit csr(const SpMat& A);
+
+/**
+* @brief Destructor (defaulted)
+*
+*/
+
+~csr(){}
+
+/**
+* @brief Number of rows
+*
+*/
+
+inline int rows() const
+{
+return _rows;
+}
+
+/**
+* @brief Number of columns
+*
+*/
+
+inline int cols() const
+{
+return _cols;
+}
+
+/**
+* @brief Number of stored nonzeros
+*
+*/
+
+inline int nonZeros() const
+{
+return _col.size();
+}
+
+/**
+* @brief Number of nonzeros of the full matrix, counting both positions of entries of the upper triangle in half storage
+*
+*/
+
+inline int entries() const
+{
+return _upper ? 2*_col.size()-_ndiag : _col.size();
+}
+
+/**
+* @brief Check if only the upper triangle is stored
+*
+*/
+
+inline bool isUpper() const
+{
+return _upper;
+}
+
+/**
+* @brief Row pointers: row i is stored in positions outerIndexPtr()[i],...,outerIndexPtr()[i+1]-1
+*
+*/
+
+inline const int* outerIndexPtr() const
+{
+return _ptr.data();
+}
+
+inline int* outerIndexPtr()
+{
+return _ptr.data();
+}
+
+/**
+* @brief Column indices of nonzeros
+*
+*/
+
+inline const int* innerIndexPtr() const
+{
+return _col.data();
+}
+
+inline int* innerIndexPtr()
+{
+return _col.data();
+}
+
+/**
+* @brief Values of nonzeros
+*
+*/
+
+inline const Real* valuePtr() const
+{
+return _val.data();
+}
+
+inline Real* valuePtr()
+{
+return _val.data();
+}
+
+/**
+* @brief Reshaping: all rows become empty
+* @param[in] rows: number of rows
+* @param[in] cols: number of columns
+*
+*/
+
+void resize(const int& rows, const int& cols);
+
+/**
+* @brief Allocation of the nonzeros, to be filled after the row pointers
+* @param[in] nnz: number of nonzeros
+*
+*/
+
+void resizeNonZeros(const int& nnz);
+
+/**
+* @brief Reading a coefficient (0 if it is not stored), by binary search in its row
+* @param[in] i: row
+* @param[in] j: column
+*
+*/
+
+Real coeff(const int& i, const int& j) const;
+
+/**
+* @brief Reduction of a symmetric matrix to half storage: entries below the diagonal are dropped and memory is released
+*
+*/
+
+void make_upper();
+
+/**
+* @brief Product with a vector (symmetric kernel in half storage)
+* @param[in] x: input vector
+* @param[out] y: A*x
+*
+*/
+
+Vec operator*(const Vec& x) const;
+
+/**
+* @brief Forward Gauss-Seidel sweep (rows in increasing order)
+* @param[in] f: right-hand side
+* @param[in] u: initial solution guess (it will be updated in the method)
+*
+*/
+
+void forward_GS(const Vec& f, Vec& u) const;
+
+/**
+* @brief Backward Gauss-Seidel sweep (rows in decreasing order)
+* @param[in] f: right-hand side
+* @param[in] u: initial solution guess (it will be updated in the method)
+*
+*/
+
+void backward_GS(const Vec& f, Vec& u) const;
+
+/**
+* @brief Swap of the content of two matrices
+* @param[in] A: other matrix
+*
+*/
+
+void swap(csr& A);
+
+/**
+* @brief Memory allocated by the matrix, in bytes
+*
+*/
+
+size_t bytes() const;
+
+/**
+* @brief View of the matrix as an Eigen sparse matrix, valid while the matrix is not modified (in half storage only the upper triangle is seen)
+*
+*/
+
+inline Map<const SpMat> eigen() const
+{
+return Map<const SpMat>(_rows,_cols,_col.size(),_ptr.data(),_col.data(),_val.data());
+}
+
+private:
+int _rows=0; /**< @brief number of rows */
+int _cols=0; /**< @brief number of columns */
+bool _upper=0; /**< @brief flag associated with half storage */
+int _ndiag=0; /**< @brief number of stored diagonal entries, in half storage */
+vector<int,cache_allocator<int> > _ptr; /**< @brief row pointers */
+vector<int,cache_allocator<int> > _col; /**< @brief column indices of nonzeros */
+vector<Real,cache_allocator<Real> > _val; /**< @brief values of nonzeros */
+};
+
+#endif // CSR_H_INCLUDED
@@ -69,7 +69,7 @@ return _S;
 
 inline const Vec& get_u(const size_t& n)
 {
-if (n >= _pc.get_nlevel())  
+if (n > _nlevel)  
 {
 	throw out_of_range("Index out of range.");
 }
@@ -86,7 +86,7 @@ return _u[n];
 
 inline void set_u(const size_t& n,const Vec& v)
 {
-if (n >= _pc.get_nlevel()) 
+if (n > _nlevel) 
 {
 	throw out_of_range("Index out of range.");
 }
@@ -102,7 +102,7 @@ _u[n]=v;
 
 inline const Vec& get_f(const size_t& n)
 {
-if (n >= _pc.get_nlevel()) 
+if (n > _nlevel) 
 {
 throw out_of_range("Index out of range.");
 }
@@ -119,7 +119,7 @@ return _f[n];
 
 inline void set_f(const size_t& n,const Vec& v)
 {
-if (n >= _pc.get_nlevel())  
+if (n > _nlevel)  
 {
 throw out_of_range("Index out of range.");
 }
@@ -151,6 +151,7 @@ setup _S; /**< @brief setup containing coarser matrices and interpolation operat
 vector<Vec> _f; /**< @brief vector of right-hand side on all levels */
 vector<Vec> _u; /**< @brief vector of solution on all levels */
 parameter_cycle _pc; /**< @brief parameters of cycle */
+int _nlevel; /**< @brief number of coarser levels built by setup, nlevel in parameters of cycle is an upper bound */
 };
 
 
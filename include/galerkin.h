@@ -0,0 +1,92 @@
+/**
+* @file   galerkin.h
+* @author Laura Melas <laura.melas@mail.polimi.it>
+* @date   2017
+*
+* This file is part of project "AMG Methods".
+*
+* @brief AMG methods for conforming and discontinuous Galerkin finite element discretizations of the Poisson problem.
+*
+*/
+
+#ifndef GALERKIN_H_INCLUDED
+#define GALERKIN_H_INCLUDED
+
+#include "arena.h"
+#include "csr.h"
+
+/** @class galerkin
+* @brief This class computes the Galerkin triple product P^T*A*P row by row, without forming P^T or A*P.
+* Row I of the product collects the rows of A selected by column I of P (found through an index of the positions of P),
+* multiplied by P and accumulated in a dense workspace. The pattern is computed once (symbolic phase) and
+* filled with values afterwards (numeric phase); for symmetric A only the upper triangle is computed and then mirrored.
+*
+*/
+
+class galerkin
+{
+public:
+
+/**
+* @brief Constructor (defaulted)
+*
+*/
+
+galerkin()=default;
+
+/**
+* @brief Constructor: symbolic phase
+* @param[in] A: matrix of the fine level
+* @param[in] P: interpolation operator
+* @param[in] symmetric: if 1 A is symmetric and only the upper triangle of the product is computed
+* @param[in] pool: arena providing the memory of the symbolic phase and of the workspaces (nullptr for the general-purpose allocator)
+*
+*/
+
+galerkin(const csr& A, const csr& P, const bool& symmetric, arena* pool=nullptr);
+
+/**
+* @brief Destructor (defaulted)
+*
+*/
+
+~galerkin(){}
+
+/**
+* @brief Numeric phase
+* @param[in] A: matrix of the fine level, with the same pattern used in the symbolic phase
+* @param[in] P: interpolation operator, with the same pattern used in the symbolic phase
+* @param[in] Ac: initialization of coarse matrix P^T*A*P, stored in full (it will be built in the method)
+*
+*/
+
+void product(const csr& A, const csr& P, csr& Ac) const;
+
+/**
+* @brief Memory allocated by the symbolic phase, in bytes
+*
+*/
+
+size_t bytes() const;
+
+private:
+
+/**
+* @brief Utility: mirror of an upper triangular matrix into a full symmetric matrix
+* @param[in] U: upper triangular matrix
+* @param[in] Ac: initialization of full matrix (it will be built in the method)
+*
+*/
+
+static void mirror(const csr& U, csr& Ac);
+
+int _nc; /**< @brief number of coarse points */
+bool _upper; /**< @brief flag associated with computation of the upper triangle only */
+avector<int> _tptr; /**< @brief index of column I of P: positions _tptr[I],...,_tptr[I+1]-1 of _trow and _tpos */
+avector<int> _trow; /**< @brief fine rows of the nonzeros of each column of P */
+avector<int> _tpos; /**< @brief positions in P of the nonzeros of each column of P */
+avector<int> _cptr; /**< @brief row pointers of the computed pattern of the coarse matrix */
+avector<int> _ccol; /**< @brief sorted column indices of the computed pattern of the coarse matrix */
+};
+
+#endif // GALERKIN_H_INCLUDED
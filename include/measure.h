@@ -0,0 +1,140 @@
+/**
+* @file   measure.h
+* @author Laura Melas <laura.melas@mail.polimi.it>
+* @date   2017
+*
+* This file is part of project "AMG Methods".
+*
+* @brief AMG methods for conforming and discontinuous Galerkin finite element discretizations of the Poisson problem.
+*
+*/
+
+#ifndef MEASURE_H_INCLUDED
+#define MEASURE_H_INCLUDED
+
+#include "common.h"
+
+/** @class measure
+* @brief This class stores the measure lambda of the C/F splitting as buckets of points with equal measure.
+* Each bucket is a hierarchical bitmap (64 bits per word, one word per 64 words of the level below), so increment, decrement and removal
+* touch a constant number of words and the point with maximum measure and smallest index is found descending from the top word.
+*
+*/
+
+class measure
+{
+public:
+
+/**
+* @brief Constructor (defaulted)
+*
+*/
+
+measure()=default;
+
+/**
+* @brief Constructor
+* @param[in] lambda: initial measure of all points, it has to be non-negative
+*
+*/
+
+measure(const vector<int>& lambda);
+
+/**
+* @brief Destructor (defaulted)
+*
+*/
+
+~measure(){}
+
+/**
+* @brief Reading measure of a point
+* @param[in] i: point
+* @param[out] lambda[i]: measure of the point, -1 if it has been removed
+*
+*/
+
+inline const int& operator[](const size_t& i) const
+{
+if (i >= _lambda.size())
+{
+	throw out_of_range("Index out of range.");
+}
+return _lambda[i];
+}
+
+/**
+* @brief Increase by one the measure of a point
+* @param[in] i: point, it must not have been removed
+*
+*/
+
+void increment(const int& i);
+
+/**
+* @brief Decrease by one the measure of a point, measure zero is left unchanged
+* @param[in] i: point, it must not have been removed
+*
+*/
+
+void decrement(const int& i);
+
+/**
+* @brief Remove a point
+* @param[in] i: point, removing twice the same point has no effect
+*
+*/
+
+void remove(const int& i);
+
+/**
+* @brief Point with maximum measure
+* @param[out] i: point with maximum measure and smallest index among them, -1 if all points have been removed
+*
+*/
+
+int top();
+
+/**
+* @brief Check if all points have been removed
+* @param[out] 0,1    : 1 if all points have been removed, 0 otherwise
+*
+*/
+
+bool isEmpty();
+
+private:
+
+/**
+* @brief Insert a point in a bucket
+* @param[in] i: point
+* @param[in] b: bucket
+*
+*/
+
+void insert(const int& i, const int& b);
+
+/**
+* @brief Erase a point from a bucket
+* @param[in] i: point
+* @param[in] b: bucket
+*
+*/
+
+void erase(const int& i, const int& b);
+
+/**
+* @brief Check if a bucket is empty
+* @param[in] b: bucket
+* @param[out] 0,1    : 1 if the bucket is empty, 0 otherwise
+*
+*/
+
+bool empty_bucket(const int& b) const;
+
+vector<int> _lambda; /**< @brief measure of all points, -1 for removed points */
+vector<vector<vector<uint64_t> > > _bucket; /**< @brief bitmap levels of all buckets, _bucket[b][0] has one bit per point */
+int _top; /**< @brief upper bound of the highest non-empty bucket */
+};
+
+#endif // MEASURE_H_INCLUDED
@@ -43,13 +43,18 @@ output()=default;
 * @param[in] iter: number of iterations to achieve convergence
 * @param[in] rho: convergence factor
 * @param[in] flag: flag associated with convergence (0 convergence, 1 otherwise)
+* @param[in] levels: number of levels of the hierarchy built by setup
+* @param[in] complexity: operator complexity of the hierarchy
+* @param[in] hierarchy_bytes: memory of the hierarchy, in bytes
+* @param[in] peak_bytes: peak memory of setup, in bytes
+* @param[in] spectral_radius: estimated spectral radius of D^-1*A on the finest level (0 if not estimated)
 * @param[in] parameter_setup: parameters of setup
 * @param[in] parameter_cycle: parameters of cycle
 * @param[in] parameter_method: parameters of method
 *
 */
 
-output(const string& testname,const string& inputA, const string& inputf, const string& fem, const string& method, const int& iter,const Real& rho, const bool& flag, const parameter_setup& ps, const parameter_cycle& pc, const parameter_method& pm);
+output(const string& testname,const string& inputA, const string& inputf, const string& fem, const string& method, const int& iter,const Real& rho, const bool& flag, const int& levels, const Real& complexity, const size_t& hierarchy_bytes, const size_t& peak_bytes, const Real& spectral_radius, const parameter_setup& ps, const parameter_cycle& pc, const parameter_method& pm);
 
 /**
 * @brief Destructor (defaulted)
@@ -82,6 +87,11 @@ string _method; /**< @brief type of AMG method (AMG as stand-alone, PCG as preco
 int _iter; /**< @brief number of iterations to achieve convergence */
 bool _flag; /**< @brief flag associated with convergence (0 convergence, 1 otherwise) */
 Real _rho; /**< @brief convergence factor */
+int _levels; /**< @brief number of levels of the hierarchy */
+Real _complexity; /**< @brief operator complexity of the hierarchy */
+size_t _hierarchy_bytes; /**< @brief memory of the hierarchy, in bytes */
+size_t _peak_bytes; /**< @brief peak memory of setup, in bytes */
+Real _spectral_radius; /**< @brief estimated spectral radius of D^-1*A on the finest level */
 parameter_setup _ps; /**< @brief parameters of setup */
 parameter_cycle _pc; /**< @brief parameters of cycle */
 parameter_method _pm; /**< @brief parameters of method */
@@ -35,10 +35,24 @@ parameter_setup()=default;
 * @brief Constructor
 * @param[in] nmatrix: number of coarser matrices
 * @param[in] theta: strong connection threshold
+* @param[in] coarsening: C/F splitting algorithm (RS Ruge-Stuben, PMIS parallel modified independent set, HMIS hybrid modified independent set)
+* @param[in] seed: seed of the random weights of PMIS/HMIS and MIS aggregation
+* @param[in] trunc_factor: relative drop tolerance of interpolation weights (0 no dropping)
+* @param[in] max_elements: maximum number of interpolation weights in each row (0 no limit)
+* @param[in] aggressive_levels: number of finest levels with aggressive coarsening and multipass interpolation
+* @param[in] max_coarse_size: coarsening stops at the first matrix with at most max_coarse_size rows (0 no limit)
+* @param[in] max_coarse_ratio: coarsening stops when coarse/fine size ratio is above max_coarse_ratio (1 no limit)
+* @param[in] half_storage: if 1 only the upper triangle of symmetric matrices of the hierarchy is stored
+* @param[in] omega: damping of the smoothing step of aggregation prolongators (0 for 4/(3*rho), rho estimated spectral radius of D^-1*A)
+* @param[in] hierarchy: type of levels (classical, or SA smoothed aggregation on every level)
+* @param[in] aggregation: aggregation algorithm of smoothed aggregation levels other than the finest DG level (standard neighbourhood aggregation, matching or MIS)
+* @param[in] aggregation_ratio: target coarsening ratio of matching aggregation
+* @param[in] aggregation_DG: aggregation algorithm of the finest DG level (pairwise or MIS)
+* @param[in] theta_DG: strong connection threshold of MIS aggregation on the finest DG level
 *
 */
 
-parameter_setup(const int& nmatrix,const Real& theta);
+parameter_setup(const int& nmatrix,const Real& theta,const string& coarsening="RS",const int& seed=0,const Real& trunc_factor=0,const int& max_elements=0,const int& aggressive_levels=0,const int& max_coarse_size=0,const Real& max_coarse_ratio=1,const bool& half_storage=0,const Real& omega=0,const string& hierarchy="classical",const string& aggregation="standard",const Real& aggregation_ratio=8,const string& aggregation_DG="pairwise",const Real& theta_DG=1);
 
 /**
 * @brief Destructor (defaulted)
@@ -69,9 +83,177 @@ inline const Real& get_theta() const
 return _theta;
 }
 
+/**
+* @brief Reading parameter coarsening
+* @param[out] coarsening: C/F splitting algorithm (RS, PMIS or HMIS)
+*
+*/
+
+inline const string& get_coarsening() const
+{
+return _coarsening;
+}
+
+/**
+* @brief Reading parameter seed
+* @param[out] seed: seed of the random weights of PMIS/HMIS and MIS aggregation
+*
+*/
+
+inline const int& get_seed() const
+{
+return _seed;
+}
+
+/**
+* @brief Reading parameter trunc_factor
+* @param[out] trunc_factor: relative drop tolerance of interpolation weights (0 no dropping)
+*
+*/
+
+inline const Real& get_trunc_factor() const
+{
+return _trunc_factor;
+}
+
+/**
+* @brief Reading parameter max_elements
+* @param[out] max_elements: maximum number of interpolation weights in each row (0 no limit)
+*
+*/
+
+inline const int& get_max_elements() const
+{
+return _max_elements;
+}
+
+/**
+* @brief Reading parameter aggressive_levels
+* @param[out] aggressive_levels: number of finest levels with aggressive coarsening and multipass interpolation
+*
+*/
+
+inline const int& get_aggressive_levels() const
+{
+return _aggressive_levels;
+}
+
+/**
+* @brief Reading parameter max_coarse_size
+* @param[out] max_coarse_size: coarsening stops at the first matrix with at most max_coarse_size rows (0 no limit)
+*
+*/
+
+inline const int& get_max_coarse_size() const
+{
+return _max_coarse_size;
+}
+
+/**
+* @brief Reading parameter max_coarse_ratio
+* @param[out] max_coarse_ratio: coarsening stops when coarse/fine size ratio is above max_coarse_ratio (1 no limit)
+*
+*/
+
+inline const Real& get_max_coarse_ratio() const
+{
+return _max_coarse_ratio;
+}
+
+/**
+* @brief Reading parameter half_storage
+* @param[out] half_storage: if 1 only the upper triangle of symmetric matrices of the hierarchy is stored
+*
+*/
+
+inline const bool& get_half_storage() const
+{
+return _half_storage;
+}
+
+/**
+* @brief Reading parameter omega
+* @param[out] omega: damping of the smoothing step of aggregation prolongators (0 for 4/(3*rho), rho estimated spectral radius of D^-1*A)
+*
+*/
+
+inline const Real& get_omega() const
+{
+return _omega;
+}
+
+/**
+* @brief Reading parameter hierarchy
+* @param[out] hierarchy: type of levels (classical, or SA smoothed aggregation on every level)
+*
+*/
+
+inline const string& get_hierarchy() const
+{
+return _hierarchy;
+}
+
+/**
+* @brief Reading parameter aggregation
+* @param[out] aggregation: aggregation algorithm of smoothed aggregation levels other than the finest DG level (standard neighbourhood aggregation, matching or MIS)
+*
+*/
+
+inline const string& get_aggregation() const
+{
+return _aggregation;
+}
+
+/**
+* @brief Reading parameter aggregation_ratio
+* @param[out] aggregation_ratio: target coarsening ratio of matching aggregation
+*
+*/
+
+inline const Real& get_aggregation_ratio() const
+{
+return _aggregation_ratio;
+}
+
+/**
+* @brief Reading parameter aggregation_DG
+* @param[out] aggregation_DG: aggregation algorithm of the finest DG level (pairwise or MIS)
+*
+*/
+
+inline const string& get_aggregation_DG() const
+{
+return _aggregation_DG;
+}
+
+/**
+* @brief Reading parameter theta_DG
+* @param[out] theta_DG: strong connection threshold of MIS aggregation on the finest DG level
+*
+*/
+
+inline const Real& get_theta_DG() const
+{
+return _theta_DG;
+}
+
 private:
-int _nmatrix; /**< @brief number of coarser matrices */
+int _nmatrix; /**< @brief maximum number of coarser matrices */
 Real _theta; /**< @brief strong connection threshold */
+string _coarsening; /**< @brief C/F splitting algorithm (RS, PMIS or HMIS) */
+int _seed; /**< @brief seed of the random weights of PMIS/HMIS and MIS aggregation */
+Real _trunc_factor; /**< @brief relative drop tolerance of interpolation weights */
+int _max_elements; /**< @brief maximum number of interpolation weights in each row */
+int _aggressive_levels; /**< @brief number of finest levels with aggressive coarsening */
+int _max_coarse_size; /**< @brief maximum size of coarsest matrix */
+Real _max_coarse_ratio; /**< @brief maximum coarse/fine size ratio */
+bool _half_storage; /**< @brief flag associated with storage of the upper triangle only */
+Real _omega; /**< @brief damping of the smoothing step of aggregation prolongators */
+string _hierarchy; /**< @brief type of levels (classical or SA) */
+string _aggregation; /**< @brief aggregation algorithm (standard, matching or MIS) */
+Real _aggregation_ratio; /**< @brief target coarsening ratio of matching aggregation */
+string _aggregation_DG; /**< @brief aggregation algorithm of the finest DG level (pairwise or MIS) */
+Real _theta_DG; /**< @brief strong connection threshold of MIS aggregation on the finest DG level */
 };
 
 #endif // PARAMETER_SETUP_H_INCLUDED
@@ -12,11 +12,12 @@
 #ifndef SETS_INCLUDED
 #define SETS_INCLUDED
 
-#include "common.h"
+#include "arena.h"
 
 /** @class sets
 * @brief This class performs some properties and utilities of mathematical sets.
-*
+* Elements are kept sorted and without repetitions. If the universe {0,...,n-1} of the set is known and the set is dense in it,
+* a bitmap of the universe is kept along with the elements, so that membership is checked in constant time.
 *
 */
 
@@ -33,11 +34,12 @@ sets()=default;
 
 /**
 * @brief Constructor
-* @param[in] dim: cardinality of the set
+* @param[in] n: size of the universe {0,...,n-1} of the set, the set is initialized empty
+* @param[in] pool: arena providing the memory of the set (nullptr for the general-purpose allocator)
 *
 */
 
-sets(const size_t& dim);
+sets(const size_t& n, arena* pool=nullptr);
 
 /**
 * @brief Copy constructor
@@ -55,22 +57,7 @@ sets(const sets& A);
 ~sets(){}
 
 /**
-* @brief Definition of operator [], writing version
-* @param[in] n: access position to an element of the set 
-* @param[out] set[n]: write element in the choosen position of the set 
-*
-*/
-
-inline int& operator[](const size_t& n){
-if (n >= _set.size()) 
-{
-	throw out_of_range("Index out of range.");
-}
-return _set[n];
-}
-
-/**
-* @brief Definition of operator [], reading version
+* @brief Definition of operator [], reading version (elements are sorted)
 * @param[in] n: access position to an element of the set 
 * @param[out] set[n]: read element in the choosen position of the set 
 *
@@ -85,7 +72,7 @@ return _set[n];
 }
 
 /**
-* @brief Add an element in the set
+* @brief Add an element in the set keeping it sorted, in constant time if it is larger than all elements
 * @param[in] s: element to be added
 *
 */
@@ -107,7 +94,7 @@ void deleteElement(const int& s);
 *
 */
 
-bool isMember(const int& s);
+bool isMember(const int& s) const;
 
 /**
 * @brief Check if a set is empty
@@ -115,57 +102,75 @@ bool isMember(const int& s);
 *
 */
 
-bool isEmpty();
+bool isEmpty() const;
 
 /**
 * @brief Find the position of an element in the set
 * @param[in] s: element to be found
-* @param[out] d : position of the element
+* @param[out] d : position of the element (cardinality of the set if s is not in the set)
 *
 */
 
-int find_pos_set(const int& s);
+int find_pos_set(const int& s) const;
 
 /**
 * @brief Cardinality of the set
 *
 */
 
-int cardinality();
+int cardinality() const;
 
 /**
 * @brief Union between two sets
-* @param[out] U    : union set between A and B
 * @param[in]  A,B        : two sets
+* @param[in]  U    : union set between A and B, its memory is reused (it will be built in the method, it must be different from A and B)
 *
 */
 
-static sets union_set(sets& A,sets& B);
+static void union_set(const sets& A,const sets& B,sets& U);
 
 /**
 * @brief Difference between two sets 
-* @param[out] D    : difference set between A and B (D=A-B)
 * @param[in]  A,B        : two sets
+* @param[in]  D    : difference set between A and B (D=A-B), its memory is reused (it will be built in the method, it must be different from A and B)
 *
 */
 
-static sets diff_set(sets& A,sets& B);
+static void diff_set(const sets& A,const sets& B,sets& D);
 
 /**
 * @brief Intersection between two sets
-* @param[out] I    : intersection set between A and B
 * @param[in]  A,B        : two sets
+* @param[in]  I    : intersection set between A and B, its memory is reused (it will be built in the method, it must be different from A and B)
+*
+*/
+
+static void inter_set(const sets& A,const sets& B,sets& I);
+
+/**
+* @brief In-place union with another set
+* @param[in] B: set to be added
+* @param[in] buffer: workspace, its memory is reused and exchanged with the set
 *
 */
 
-static sets inter_set(sets& A,sets& B);
+void union_with(const sets& B,sets& buffer);
 
 /**
-* @brief Reorder the set
+* @brief In-place difference with another set, without allocation
+* @param[in] B: set to be removed
 *
 */
 
-void sort_set();
+void diff_with(const sets& B);
+
+/**
+* @brief In-place intersection with another set, without allocation
+* @param[in] B: set to be intersected
+*
+*/
+
+void inter_with(const sets& B);
 
 /**
 * @brief Delete all element of the set
@@ -174,8 +179,25 @@ void sort_set();
 
 void clear_set();
 
+/**
+* @brief Memory allocated by the set, in bytes
+*
+*/
+
+size_t bytes() const;
+
 private:
-vector<int> _set; /**< @brief definition of set */
+
+/**
+* @brief Utility: bitmap of the universe is built when the set becomes dense in it and released when it becomes sparse
+*
+*/
+
+void update_bitmap();
+
+avector<int> _set; /**< @brief sorted elements of the set */
+size_t _n=0; /**< @brief size of the universe of the set (0 if unknown) */
+avector<uint64_t> _bits; /**< @brief bitmap of the universe (empty if the set is sparse) */
 };
 
 #endif // SETS_INCLUDED
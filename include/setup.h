@@ -13,6 +13,9 @@
 #define SETUP_H_INCLUDED
 
 #include "sets.h"
+#include "adjacency.h"
+#include "strength.h"
+#include "csr.h"
 #include "parameter_setup.h"
 
 /** @class setup
@@ -55,7 +58,7 @@ setup(const SpMat& A,const parameter_setup& p);
 *
 */
 
-inline const SpMat& get_A(const size_t& n) const
+inline const csr& get_A(const size_t& n) const
 {
 if (n >= _A.size()) {
 	throw out_of_range("Index out of range.");
@@ -70,7 +73,7 @@ return _A[n];
 *
 */
 
-inline const SpMat& get_I(const size_t& n) const
+inline const csr& get_I(const size_t& n) const
 {
 if (n >= _I.size()) {
 	throw out_of_range("Index out of range.");
@@ -78,97 +81,436 @@ if (n >= _I.size()) {
 return _I[n];
 }
 
-protected:
+/**
+* @brief Number of coarser levels built, the coarsest matrix is get_A(get_nlevel())
+* @param[out] nlevel: number of interpolation operators
+*
+*/
+
+inline int get_nlevel() const
+{
+return _I.size();
+}
 
 /**
-* @brief Definition of strong connections
-* @param[in] A: input matrix defined on finest level
-* @param[in] S: initialization of vector of sets containing all strong dependence connections (it will be built in the method)
-* @param[in] St: initialization of vector of sets containing all strong influence conncetions (it will be built in the method)
-* @param[in] Dw: initialization of vector of sets containing all weak connections (it will be built in the method)
+* @brief Operator complexity of the hierarchy
+* @param[out] c: sum of nonzeros of all matrices divided by nonzeros of finest matrix
+*
+*/
+
+Real operator_complexity() const;
+
+/**
+* @brief Memory allocated by the hierarchy (all matrices and interpolation operators), in bytes
+*
+*/
+
+size_t hierarchy_bytes() const;
+
+/**
+* @brief Peak memory of setup, in bytes: largest memory of the hierarchy plus the temporaries alive at the end of each setup step
+*
+*/
+
+inline const size_t& peak_bytes() const
+{
+return _peak;
+}
+
+/**
+* @brief Reading the estimate of the spectral radius of D^-1*A on the finest level, used to damp the smoothing of aggregation prolongators
+* @param[out] rho: estimated spectral radius (0 if setup did not need it: no aggregation level, or omega given in setup parameters)
 *
 */
 
-void strong_influence_dependence(const SpMat& A, vector<sets>& S, vector<sets>& St, vector<sets>& Dw);
+inline const Real& get_spectral_radius() const
+{
+return _rho;
+}
+
+protected:
 
 /**
 * @brief First step of coarsening strategy: C/F splitting
-* @param[in] S: vector of sets containing all strong dependence connections
-* @param[in] St: vector of sets containing all strong influence conncetions
+* @param[in] G: strength-of-connection graph
 * @param[in] C: initialization of C-points (it will be built in the method)
 * @param[in] F: initialization of F-points (it will be built in the method)
 *
 */
 
-void colouring_scheme(vector<sets>& S, vector<sets>& St, sets& C, sets& F);
+void colouring_scheme(const strength& G, sets& C, sets& F);
 
 /**
-* @brief Definition of vectors of coarse-interpolatory sets and of strong non-interpolatory sets
-* @param[in] S: vector of sets containing all strong dependence connections
-* @param[in] Ci: initialization of vector of coarse interpolatory sets (it will be built in the method)
-* @param[in] Ds: initialization of vector of strong non-interpolatory sets (it will be built in the method)
-* @param[in] C: C-points of C/F-splitting
+* @brief First pass of Ruge-Stuben C/F splitting restricted to a block of consecutive points, only connections inside the block are considered
+* @param[in] G: strength-of-connection graph
+* @param[in] cf: state of all points (1 C-point, -1 F-point, 0 undecided), points of the block are decided in the method
+* @param[in] first: first point of the block
+* @param[in] last: one past the last point of the block
+* @param[in] hybrid: if 1 points without strong influence inside the block are left undecided, otherwise they become C-points
+*
+*/
+
+void first_pass(const strength& G, avector<int>& cf, const int& first, const int& last, const bool& hybrid);
+
+/**
+* @brief Parallel modified independent set (PMIS): completes a C/F splitting with synchronous rounds, it runs with OpenMP
+* @param[in] G: strength-of-connection graph
+* @param[in] cf: state of all points (1 C-point, -1 F-point, 0 undecided), undecided points are decided in the method
 *
 */
 
-void coarse_strong_dependence(vector<sets>& S, vector<sets>& Ci, vector<sets>& Ds, sets C);
+void independent_set(const strength& G, avector<int>& cf);
 
 /**
-* @brief Second step of coarsening strategy: C/F splitting
+* @brief Second pass of PMIS/HMIS: F-points with a strong F-neighbour without common C-point become C-points, in synchronous rounds among an independent set of candidates, it runs with OpenMP
+* @param[in] G: strength-of-connection graph
+* @param[in] cf: state of all points (1 C-point, -1 F-point), it will be modified in the method
+*
+*/
+
+void parallel_second_pass(const strength& G, avector<int>& cf);
+
+/**
+* @brief Utility: check if a point has the maximum weight among its neighbours in a given state, with respect to the symmetrized strength graph (ties are broken by index)
+* @param[in] G: strength-of-connection graph
+* @param[in] w: weights of all points
+* @param[in] state: state of all points
+* @param[in] i: point
+* @param[in] s: state of neighbours to be compared
+* @param[out] 0,1    : 1 if i has maximum weight, 0 otherwise
+*
+*/
+
+bool is_local_max(const strength& G, const avector<Real>& w, const avector<int>& state, const int& i, const int& s);
+
+/**
+* @brief Parallel C/F splitting: PMIS, or HMIS (Ruge-Stuben first pass inside each thread block followed by PMIS)
+* @param[in] G: strength-of-connection graph
+* @param[in] C: initialization of C-points (it will be built in the method)
+* @param[in] F: initialization of F-points (it will be built in the method)
+*
+*/
+
+void parallel_coarsening(const strength& G, sets& C, sets& F);
+
+/**
+* @brief Aggressive C/F splitting: the splitting chosen in setup parameters is applied twice, the second time only to first-stage C-points
+* with strong dependence given by strong paths of length at most 2; RS is used again as RS, PMIS and HMIS as PMIS
+* @param[in] G: strength-of-connection graph
+* @param[in] C: initialization of C-points (it will be built in the method)
+* @param[in] F: initialization of F-points (it will be built in the method)
+*
+*/
+
+void aggressive_coarsening(const strength& G, sets& C, sets& F);
+
+/**
+* @brief C/F splitting chosen in setup parameters, followed by definition of coarse-interpolatory sets
+* @param[in] G: strength-of-connection graph
+* @param[in] Ci: initialization of coarse interpolatory sets (they will be built in the method)
+* @param[in] C: initialization of C-points (it will be built in the method)
+* @param[in] F: initialization of F-points (it will be built in the method)
+*
+*/
+
+void CF_splitting(const strength& G, adjacency& Ci, sets& C, sets& F);
+
+/**
+* @brief Definition of coarse-interpolatory sets Ci_i (strong dependences of i among C-points), strong non-interpolatory sets are the remaining strong dependences
+* @param[in] G: strength-of-connection graph
+* @param[in] Ci: initialization of coarse interpolatory sets (they will be built in the method)
+* @param[in] C: sorted C-points of C/F-splitting
+*
+*/
+
+void coarse_strong_dependence(const strength& G, adjacency& Ci, const sets& C);
+
+/**
+* @brief Second step of coarsening strategy: C/F splitting, F-points with a strong non-interpolatory point without common coarse interpolatory point become C-points;
+* coarse interpolatory and strong non-interpolatory sets are read from the strength graph and the current C-points
+* @param[in] G: strength-of-connection graph
 * @param[in] C: C-points of C/F-splitting
 * @param[in] F: F-points of C/F-splitting
-* @param[in] Ci: vector of coarse interpolatory sets
-* @param[in] Ds: vector of strong non-interpolatory sets
 *
 */
 
-void check_modify(sets& C, sets& F, vector<sets>& Ci, vector<sets>& Ds);
+void check_modify(const strength& G, sets& C, sets& F);
 
 /**
 * @brief Interpolation formula
 * @param[in] A: input matrix defined on finest level
 * @param[in] I: initialization of interpolation operator (it will be built in the method)
 * @param[in] C: C-points of C/F-splitting
-* @param[in] Ci: vector of coarse interpolatory sets
-* @param[in] Ds: vector of strong non-interpolatory sets
-* @param[in] Dw: vector of weak non-interpolatory sets
+* @param[in] cidx: position of each point in C (-1 for F-points)
+* @param[in] Ci: coarse interpolatory sets
+* @param[in] G: strength-of-connection graph, strong non-interpolatory and weak sets of a point are its strong connections outside Ci and its weak connections
 *
 */
 
+void interpolation(const csr& A, SpMat& I, const sets& C, const avector<int>& cidx, const adjacency& Ci, const strength& G);
 
-void interpolation(const SpMat& A, SpMat& I, sets& C, const vector<sets>& Ci, const vector<sets>& Ds, const vector<sets>& Dw);
+/**
+* @brief Interpolation weights of one F-point, computed with dense workspaces scattered from the rows of A, without allocation;
+* strong non-interpolatory neighbours with no nonzero connection to Ci_i do not contribute
+* @param[in] A: input matrix defined on finest level
+* @param[in] G: strength-of-connection graph of A
+* @param[in] Ci: coarse interpolatory sets
+* @param[in] i: F-point
+* @param[in] marker: workspace of size A.rows(), marker[j]==i if j is in Ci_i (it will be modified in the method)
+* @param[in] acc: workspace of size A.rows(), on exit acc[j] is the weight of j in Ci_i (it will be modified in the method)
+*
+*/
+
+void interpolation_weights(const csr& A, const strength& G, const adjacency& Ci, const int& i, avector<int>& marker, avector<Real>& acc);
 
 /**
-* @brief Construnction of coarser matrices and interpolation operators for matrix stemming from conforming Galerkin discretization 
+* @brief Multipass interpolation: F-points are sorted in passes by their distance from C-points along strong connections,
+* in each pass the rows of interpolation are combinations of the rows of strong neighbours interpolated in earlier passes
+* (direct interpolation in the first pass), scaled separately for negative and positive entries to keep row sums
+* @param[in] A: input matrix
+* @param[in] I: initialization of interpolation operator (it will be built in the method)
+* @param[in] C: sorted C-points of C/F-splitting
+* @param[in] cidx: position of each point in C (-1 for F-points)
+* @param[in] G: strength-of-connection graph of A
 *
 */
 
-void CG_setup();
+void multipass_interpolation(const csr& A, SpMat& I, const sets& C, const avector<int>& cidx, const strength& G);
 
 /**
-* @brief Utility: 
-* @param[in] A: input matrix defined on finest level
-* @param[in] B: indices set
-* @param[in] c: index
-* @param[out] Aeval: vector containing all values of A(B,c)
+* @brief Truncation of interpolation operator: weights smaller than trunc_factor times the largest weight of their row are dropped,
+* then only the max_elements largest weights of each row are kept; remaining positive and negative weights are rescaled separately
+* to keep the sums of positive and of negative weights of each row
+* @param[in] I: interpolation operator (it will be modified in the method)
 *
 */
 
-vector<Real> element_set(const SpMat& A, sets& B, const int& c);
+void truncation(SpMat& I);
 
 /**
-* @brief Utility: 
-* @param[in] A: input matrix defined on finest level
-* @param[in] maxrow: initialization of vector containing maximum values of all matrix rows (it will be built in the method)
-* @param[in] maxcol: initialization of vector containing maximum values of all matrix columns (it will be built in the method)
+* @brief Coarse matrix I^T*A*I, computed by the Galerkin triple product kernel (upper triangle only when A is symmetric)
+* @param[in] A: matrix of the fine level
+* @param[in] I: interpolation operator
+* @param[in] Ac: initialization of coarse matrix (it will be built in the method)
+*
+*/
+
+void galerkin_product(const csr& A, const csr& I, csr& Ac);
+
+/**
+* @brief Estimate of the spectral radius of D^-1*A (D diagonal of A) by Lanczos iterations on the similar symmetric matrix D^-1/2*A*D^-1/2,
+* the estimate is the largest Ritz value
+* @param[in] A: symmetric matrix with positive diagonal
+* @param[in] steps: number of Lanczos iterations
+* @param[out] rho: estimated spectral radius
+*
+*/
+
+Real spectral_radius(const csr& A, const int& steps=15) const;
+
+/**
+* @brief Dense map from points to coarse points
+* @param[in] C: sorted C-points of C/F-splitting
+* @param[in] n: number of points
+* @param[in] cidx: initialization of position of each point in C, -1 for F-points (it will be built in the method)
+*
+*/
+
+void coarse_index(const sets& C, const int& n, avector<int>& cidx);
+
+/**
+* @brief Classical AMG level: C/F splitting (aggressive on the first aggressive_levels classical levels, counted from the first one built), interpolation, truncation and coarse matrix
+* @param[in] k: level of the fine matrix
+* @param[out] 0,1    : 0 if coarsening stalls and no level is added, 1 otherwise
+*
+*/
+
+bool classical_level(const int& k);
+
+/**
+* @brief Smoothed aggregation level: aggregation, tentative interpolation operator, normalization, smoothing step, truncation and coarse matrix
+* @param[in] k: level of the fine matrix
+* @param[in] pairwise: if 1 finest level of discontinuous Galerkin matrices, aggregation_DG in setup parameters (pairwise or MIS aggregation with threshold theta_DG),
+* otherwise aggregation in setup parameters (neighbourhood aggregation on the strength graph, matching or MIS aggregation)
+* @param[out] 0,1    : 0 if coarsening stalls and no level is added, 1 otherwise
+*
+*/
+
+bool aggregation_level(const int& k, const bool& pairwise);
+
+/**
+* @brief Pairwise aggregation: each point is paired with its strongest neighbour, aggregates meeting on a negative connection are merged,
+* isolated points and points whose strongest connection is positive start singleton aggregates.
+* Members of each aggregate are kept in a linked list owned by the aggregate: a merge moves the shorter list into the longer one,
+* which is given the smaller index, so that each point is moved at most log2(n) times and the cost is O(n log n);
+* merged aggregates are kept in a free-list and reused (smallest first)
+* @param[in] k: level of the fine matrix
+* @param[in] agg: initialization of aggregate containing each point, -1 if none (it will be built in the method)
+* @param[out] nagg: number of aggregates
+*
+*/
+
+int pairwise_aggregation(const int& k, avector<int>& agg);
+
+/**
+* @brief Neighbourhood aggregation: a point whose strong neighbours are all free forms an aggregate with them, then remaining points
+* join the aggregate of a strong neighbour of the first pass, then points still left form aggregates with their free strong neighbours.
+* Points with no strong connection are not aggregated
+* @param[in] G: strength-of-connection graph
+* @param[in] agg: initialization of aggregate containing each point, -1 if none (it will be built in the method)
+* @param[out] nagg: number of aggregates
+*
+*/
+
+int neighbourhood_aggregation(const strength& G, avector<int>& agg);
+
+/**
+* @brief One pass of pairwise matching: points are visited by increasing number of unaggregated strong neighbours (a priority queue) and each one
+* is paired with the unaggregated neighbour of strong negative connection giving the best pair quality of AGMG
+* mu({i,j})=(-a_ij+(1/(a_ii+s_i+2a_ij)+1/(a_jj+s_j+2a_ij))^-1)/(-a_ij+(1/(a_ii-s_i)+1/(a_jj-s_j))^-1), s_i=-sum of off-diagonal entries of row i;
+* positive off-diagonal entries are first lumped to the diagonal (an exact match of AGMG for M-matrices).
+* Pairs with quality above 10 are rejected and the point is left alone, points with no connection are not aggregated if isolated is set
+* @param[in] A: input matrix
+* @param[in] match: initialization of pair containing each point, -1 if none (it will be built in the method)
+* @param[in] isolated: flag to leave points with no connection out of pairs; on matrices of aggregates it is unset and such aggregates are singletons
+* @param[out] np: number of pairs (singletons included)
+*
+*/
+
+int pairwise_matching(const csr& A, avector<int>& match, const bool& isolated);
+
+/**
+* @brief Matching aggregation (double pairwise): pairwise matching is applied to the matrix, then again to the matrix of the pairs P^T*A*P,
+* up to three passes, until the coarsening ratio reaches aggregation_ratio in setup parameters (aggregates of 4 to 8 points).
+* Only isolated points of the fine matrix are left out of aggregates, logic_error is thrown otherwise
+* @param[in] k: level of the fine matrix
+* @param[in] agg: initialization of aggregate containing each point, -1 if none (it will be built in the method)
+* @param[out] nagg: number of aggregates
 *
 */
 
-void minus_maxrow_maxcol(const SpMat& A,vector<Real>& maxrow, vector<Real>& maxcol);
+int matching_aggregation(const int& k, avector<int>& agg);
+
+/**
+* @brief Parallel aggregation by a distance-2 maximal independent set: in synchronous rounds an undecided point becomes a root if it has the
+* largest (state,random weight,index) within distance 2 on the symmetrized strength graph, and it is discarded if a root is within distance 2;
+* then each point joins the aggregate of a root at distance 1, and the others the aggregate of a neighbour at distance 1 from a root.
+* A final sequential cleanup pass handles points still left. Points with no strong connection are not aggregated. It runs with OpenMP
+* and the aggregates do not depend on the order of rows or on the number of threads
+* @param[in] G: strength-of-connection graph
+* @param[in] agg: initialization of aggregate containing each point, -1 if none (it will be built in the method)
+* @param[out] nagg: number of aggregates
+*
+*/
+
+int MIS_aggregation(const strength& G, avector<int>& agg);
+
+/**
+* @brief Unsmoothed interpolation formula
+* @param[in] k: level of the fine matrix
+* @param[in] I: initialization of interpolation operator (it will be built in the method)
+* @param[in] agg: aggregate containing each point, -1 if none
+* @param[in] nagg: number of aggregates
+*
+*/
+
+void unsmoothed_interpolation(const int& k, SpMat& I, const avector<int>& agg, const int& nagg);
+
+/**
+* @brief Gram-Schmidt orthonormalization applied to the interpolation formula
+* @param[in] I: interpolation operator
+*
+*/
+
+void GS_orth_interpolation(SpMat& I);
+
+/**
+* @brief Smoothing step applied to the interpolation formula: P=I-w*D^-1*A*I is computed row by row from the rows of A and I,
+* with a dense workspace in each thread, without forming D^-1*A; w is omega in setup parameters, or 4/(3*rho) with rho the estimated
+* spectral radius of D^-1*A
+* @param[in] k: level of the fine matrix
+* @param[in] I: interpolation operator (it will be replaced by the smoothed operator in the method)
+*
+*/
+
+void smoothed_interpolation(const int& k, SpMat& I);
+
+/**
+* @brief Utility: strongest off-diagonal neighbour of each point, in a single parallel sweep over the nonzeros
+* @param[in] A: input matrix
+* @param[in] pos: initialization of vector containing position of all maximum values of all matrix rows except for diagonal values, -1 for isolated points (it will be built in the method)
+* @param[in] val: initialization of vector containing the signed maximum values (it will be built in the method)
+* @param[out] n: number of isolated points (no off-diagonal nonzero)
+*
+*/
+
+static int maxrow_pos(const csr& A, avector<int>& pos, avector<Real>& val);
+
+/**
+* @brief Add a level to the hierarchy: interpolation operator is copied into the compressed storage of the hierarchy and released, then coarse matrix is built
+* and the fine matrix is reduced to half storage if required
+* @param[in] I: interpolation operator of the current level (it will be emptied in the method)
+*
+*/
+
+void add_level(SpMat& I);
+
+/**
+* @brief Update of peak memory
+* @param[in] temporary: memory of temporaries alive with the hierarchy, in bytes
+*
+*/
+
+void track(const size_t& temporary);
+
+/**
+* @brief Memory allocated by a sparse matrix, in bytes
+* @param[in] A: sparse matrix
+*
+*/
+
+static size_t matrix_bytes(const SpMat& A);
+
+/**
+* @brief Check if a matrix is small enough to be taken as coarsest (max_coarse_size in setup parameters)
+* @param[in] A: matrix of the current level
+* @param[out] 0,1    : 1 if coarsening stops at A, 0 otherwise
+*
+*/
+
+bool isCoarsest(const csr& A) const;
+
+/**
+* @brief Check if an interpolation operator gives too small reduction of size (max_coarse_ratio in setup parameters) or no coarse points
+* @param[in] I: interpolation operator of the current level
+* @param[out] 0,1    : 1 if coarsening stalls and the level is discarded, 0 otherwise
+*
+*/
+
+bool isStalled(const SpMat& I) const;
+
+/**
+* @brief End of setup: memory of temporaries is released, the coarsest matrix is reduced to half storage if required
+*
+*/
+
+void finalize();
+
+/**
+* @brief Construnction of coarser matrices and interpolation operators for matrix stemming from conforming Galerkin discretization (classical or aggregation levels)
+*
+*/
+
+void CG_setup();
 
-vector<SpMat> _A; /**< @brief vector containing coarser matrices */
-vector<SpMat> _I; /**< @brief vector containing interpolation operators */
+vector<csr> _A; /**< @brief vector containing coarser matrices */
+vector<csr> _I; /**< @brief vector containing interpolation operators */
 parameter_setup _ps; /**< @brief parameters of setup */
+bool _symmetric; /**< @brief flag associated with symmetry of the finest matrix, inherited by Galerkin coarser matrices */
+size_t _peak=0; /**< @brief peak memory of setup, in bytes */
+Real _rho=0; /**< @brief estimated spectral radius of D^-1*A on the finest level */
+int _classical=0; /**< @brief number of classical levels built */
+arena _pool; /**< @brief arena providing the memory of temporaries of setup, it is reset at each level */
 };
 
 #endif // SETUP_H_INCLUDED
@@ -52,61 +52,12 @@ setupDG(const SpMat& A,const parameter_setup& p);
 private:
 
 /**
-* @brief Aggregation
-* @param[in] B: initialization of vector of aggregate sets (it will be built in the method)
-*
-*/
-
-void aggregation_DG(vector<sets>& B);
-/**
-* @brief Unsmoothed interpolation formula
-* @param[in] I: initialization of interpolation operator (it will be built in the method)
-* @param[in] B: vector of aggregate sets
-*
-*/
-void unsmoothed_interpolation(SpMat& I, vector<sets>& B);
-
-/**
-* @brief Gram-Schmidt orthonormalization applied to the interpolation formula
-* @param[in] I: interpolation operator
-*
-*/
-
-void GS_orth_interpolation(SpMat& I);
-
-/**
-* @brief Smoothing step applied to the interpolation formula
-* @param[in] I: interpolation operator
-*
-*/
-
-void smoothed_interpolation(SpMat& I);
-
-/**
-* @brief Construnction of coarser matrices and interpolation operators for matrix stemming from discontinuous Galerkin discretization 
+* @brief Construnction of coarser matrices and interpolation operators for matrix stemming from discontinuous Galerkin discretization:
+* smoothed aggregation on the finest level, then classical levels (aggregation levels if hierarchy is SA)
 *
 */
 
 void DG_setup();
-
-/**
-* @brief Find the aggregate set containing a given value 
-* @param[in] B: vector of aggregate sets
-* @param[in] k: value to be found
-* @param[out] i: index of set containing k, if it is not found then i=-1
-*
-*/
-
-int find_set(vector<sets>& B,const int& k);
-
-/**
-* @brief Utility: 
-* @param[in] A: input matrix defined on finest level
-* @param[in] pos: initialization of vector containing position of all maximum values of all matrix rows except for diagonal values (it will be built in the method)
-*
-*/
-
-void maxrow_pos(const SpMat& A, vector<int>& pos);
 };
 
 #endif // SETUPDG_H_INCLUDED
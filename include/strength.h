@@ -0,0 +1,189 @@
+/**
+* @file   strength.h
+* @author Laura Melas <laura.melas@mail.polimi.it>
+* @date   2017
+*
+* This file is part of project "AMG Methods".
+*
+* @brief AMG methods for conforming and discontinuous Galerkin finite element discretizations of the Poisson problem.
+*
+*/
+
+#ifndef STRENGTH_H_INCLUDED
+#define STRENGTH_H_INCLUDED
+
+#include "arena.h"
+#include "csr.h"
+
+/** @class strength
+* @brief This class defines the strength-of-connection graph of a matrix as a mask over its sparsity pattern.
+* Strong dependence set S_i and weak set Dw_i are the nonzeros of row i of the matrix marked as strong or weak,
+* strong influence sets St_i are stored as compressed rows.
+* The matrix must outlive the graph, because its row pointers and column indices are not copied.
+*
+*/
+
+class strength
+{
+public:
+
+/**
+* @brief Constructor (defaulted)
+*
+*/
+
+strength()=default;
+
+/**
+* @brief Constructor
+* @param[in] A: input matrix, stored row-wise and compressed
+* @param[in] theta: strong connection threshold
+* @param[in] symmetric: if 1 A is symmetric, row maxima are used as column maxima and St is the transpose of S
+* @param[in] pool: arena providing the memory of the graph (nullptr for the general-purpose allocator)
+*
+*/
+
+strength(const csr& A, const Real& theta, const bool& symmetric, arena* pool=nullptr);
+
+/**
+* @brief Destructor (defaulted)
+*
+*/
+
+~strength(){}
+
+/**
+* @brief Check if a matrix is symmetric up to round-off
+* @param[in] A: input matrix
+* @param[out] 0,1    : 1 if A is symmetric, 0 otherwise
+*
+*/
+
+static bool isSymmetric(const SpMat& A);
+
+/**
+* @brief Number of points
+*
+*/
+
+inline int size() const
+{
+return _n;
+}
+
+/**
+* @brief First nonzero of row i of the matrix
+* @param[in] i: point
+*
+*/
+
+inline int row_begin(const int& i) const
+{
+return _ptr[i];
+}
+
+/**
+* @brief One past the last nonzero of row i of the matrix
+* @param[in] i: point
+*
+*/
+
+inline int row_end(const int& i) const
+{
+return _ptr[i+1];
+}
+
+/**
+* @brief Column index of a nonzero of the matrix
+* @param[in] k: position of the nonzero
+*
+*/
+
+inline int col(const int& k) const
+{
+return _col[k];
+}
+
+/**
+* @brief Check if a nonzero of the matrix is a strong dependence (it belongs to S_i)
+* @param[in] k: position of the nonzero
+*
+*/
+
+inline bool isStrong(const int& k) const
+{
+return _mask[k] & 1;
+}
+
+/**
+* @brief Check if a nonzero of the matrix is an off-diagonal weak connection (it belongs to Dw_i)
+* @param[in] k: position of the nonzero
+*
+*/
+
+inline bool isWeak(const int& k) const
+{
+return _mask[k] & 2;
+}
+
+/**
+* @brief First element of strong influence set St_i
+* @param[in] i: point
+*
+*/
+
+inline int St_begin(const int& i) const
+{
+return _tptr[i];
+}
+
+/**
+* @brief One past the last element of strong influence set St_i
+* @param[in] i: point
+*
+*/
+
+inline int St_end(const int& i) const
+{
+return _tptr[i+1];
+}
+
+/**
+* @brief Element of strong influence sets
+* @param[in] k: position of the element
+*
+*/
+
+inline int St_col(const int& k) const
+{
+return _tind[k];
+}
+
+/**
+* @brief Cardinality of strong influence set St_i
+* @param[in] i: point
+*
+*/
+
+inline int St_cardinality(const int& i) const
+{
+return _tptr[i+1]-_tptr[i];
+}
+
+/**
+* @brief Memory allocated by the graph, in bytes
+*
+*/
+
+size_t bytes() const;
+
+private:
+int _n; /**< @brief number of points */
+const int* _ptr; /**< @brief row pointers of the matrix */
+const int* _col; /**< @brief column indices of the matrix */
+avector<unsigned char> _mask; /**< @brief mask of all nonzeros: bit 0 strong dependence, bit 1 weak connection, bit 2 strong influence (non-symmetric matrices only) */
+avector<int> _tptr; /**< @brief row pointers of strong influence sets */
+avector<int> _tind; /**< @brief elements of strong influence sets */
+};
+
+#endif // STRENGTH_H_INCLUDED
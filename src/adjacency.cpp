@@ -0,0 +1,29 @@
+/**
+* @file   adjacency.cpp
+* @author Laura Melas <laura.melas@mail.polimi.it>
+* @date   2017
+*
+* This file is part of project "AMG Methods".
+*
+* @brief AMG methods for conforming and discontinuous Galerkin finite element discretizations of the Poisson problem.
+*
+*/
+
+#include "adjacency.h"
+
+adjacency::adjacency(const int& n, const int& nnz, arena* pool) : _ptr(1,0,pool), _ind(pool)
+{
+_ptr.reserve(n+1);
+_ind.reserve(nnz);
+}
+
+void adjacency::close_row()
+{
+sort(_ind.begin()+_ptr.back(),_ind.end());
+_ptr.push_back(_ind.size());
+}
+
+size_t adjacency::bytes() const
+{
+return (_ptr.capacity()+_ind.capacity())*sizeof(int);
+}
@@ -0,0 +1,79 @@
+/**
+* @file   arena.cpp
+* @author Laura Melas <laura.melas@mail.polimi.it>
+* @date   2017
+*
+* This file is part of project "AMG Methods".
+*
+* @brief AMG methods for conforming and discontinuous Galerkin finite element discretizations of the Poisson problem.
+*
+*/
+
+#include "arena.h"
+
+arena::~arena()
+{
+release();
+}
+
+void arena::release()
+{
+for(size_t b=0;b<_block.size();b++)
+	free(_block[b]);
+_block.clear();
+_size.clear();
+_used=0;
+}
+
+void* arena::allocate(const size_t& bytes)
+{
+size_t need=(bytes+63)/64*64;
+void* p(nullptr);
+#pragma omp critical(arena)
+{
+	bool fits(1);
+	if(_block.empty() || _used+need>_size.back()) //new block, at least twice the previous one
+	{
+		size_t size=max(need,_block.empty() ? size_t(1)<<20 : 2*_size.back());
+		void* b(nullptr);
+		fits=(posix_memalign(&b,64,size)==0);
+		if(fits)
+		{
+			_block.push_back(static_cast<char*>(b));
+			_size.push_back(size);
+			_used=0;
+		}
+	}
+	if(fits)
+	{
+		p=_block.back()+_used;
+		_used+=need;
+	}
+}
+if(p==nullptr) //exceptions cannot leave the critical section
+	throw bad_alloc();
+return p;
+}
+
+void arena::reset()
+{
+if(_block.size()>1) //blocks are merged so that the next use fits in one block
+{
+	size_t size=capacity();
+	release();
+	void* b(nullptr);
+	if(posix_memalign(&b,64,size)!=0)
+		throw bad_alloc();
+	_block.push_back(static_cast<char*>(b));
+	_size.push_back(size);
+}
+_used=0;
+}
+
+size_t arena::capacity() const
+{
+size_t c(0);
+for(size_t b=0;b<_size.size();b++)
+	c+=_size[b];
+return c;
+}
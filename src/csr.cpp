@@ -0,0 +1,184 @@
+/**
+* @file   csr.cpp
+* @author Laura Melas <laura.melas@mail.polimi.it>
+* @date   2017
+*
+* This file is part of project "AMG Methods".
+*
+* @brief AMG methods for conforming and discontinuous Galerkin finite element discretizations of the Poisson problem.
+*
+*/
+
+#include "csr.h"
+
+csr::csr(const int& rows, const int& cols)
+{
+resize(rows,cols);
+}
+
+csr::csr(const SpMat& A)
+{
+resize(A.rows(),A.cols());
+const int* outer=A.outerIndexPtr();
+const int* nnz=A.innerNonZeroPtr(); //nullptr if A is compressed
+for(int i=0;i<_rows;i++)
+	_ptr[i+1]=_ptr[i]+(nnz ? nnz[i] : outer[i+1]-outer[i]);
+resizeNonZeros(_ptr[_rows]);
+
+#pragma omp parallel for schedule(static)
+for(int i=0;i<_rows;i++)
+{
+	copy(A.innerIndexPtr()+outer[i],A.innerIndexPtr()+outer[i]+_ptr[i+1]-_ptr[i],_col.begin()+_ptr[i]);
+	copy(A.valuePtr()+outer[i],A.valuePtr()+outer[i]+_ptr[i+1]-_ptr[i],_val.begin()+_ptr[i]);
+}
+}
+
+void csr::resize(const int& rows, const int& cols)
+{
+_rows=rows;
+_cols=cols;
+_upper=0;
+_ndiag=0;
+_ptr.assign(rows+1,0);
+vector<int,cache_allocator<int> >().swap(_col); //nonzeros are released, so that resizeNonZeros allocates exactly
+vector<Real,cache_allocator<Real> >().swap(_val);
+}
+
+void csr::resizeNonZeros(const int& nnz)
+{
+_col.resize(nnz);
+_val.resize(nnz);
+}
+
+Real csr::coeff(const int& i, const int& j) const
+{
+auto first=_col.begin()+_ptr[i];
+auto last=_col.begin()+_ptr[i+1];
+auto it=lower_bound(first,last,j);
+if(it==last || *it!=j)
+	return 0;
+return _val[it-_col.begin()];
+}
+
+void csr::make_upper()
+{
+if(_upper)
+	return;
+int nnz(0);
+_ndiag=0;
+for(int i=0;i<_rows;i++) //rows are sorted, the upper part of a row is its tail
+{
+	int first=lower_bound(_col.begin()+_ptr[i],_col.begin()+_ptr[i+1],i)-_col.begin();
+	_ndiag+=(first<_ptr[i+1] && _col[first]==i);
+	int len=_ptr[i+1]-first;
+	move(_col.begin()+first,_col.begin()+_ptr[i+1],_col.begin()+nnz);
+	move(_val.begin()+first,_val.begin()+_ptr[i+1],_val.begin()+nnz);
+	_ptr[i]=nnz;
+	nnz+=len;
+}
+_ptr[_rows]=nnz;
+_col.resize(nnz);
+_val.resize(nnz);
+_col.shrink_to_fit();
+_val.shrink_to_fit();
+_upper=1;
+}
+
+Vec csr::operator*(const Vec& x) const
+{
+if(!_upper)
+	return eigen()*x;
+Vec y=Vec::Zero(_rows);
+for(int i=0;i<_rows;i++) //a stored entry (i,j) gives the products of both (i,j) and (j,i)
+{
+	Real s(0);
+	for(int k=_ptr[i];k<_ptr[i+1];k++)
+	{
+		int j=_col[k];
+		s+=_val[k]*x[j];
+		if(j>i)
+			y[j]+=_val[k]*x[i];
+	}
+	y[i]+=s;
+}
+return y;
+}
+
+void csr::forward_GS(const Vec& f, Vec& u) const
+{
+if(!_upper)
+{
+	for(int i=0;i<_rows;i++)
+	{
+		Real s=f[i],d(0);
+		for(int k=_ptr[i];k<_ptr[i+1];k++)
+		{
+			if(_col[k]==i)
+				d=_val[k];
+			else
+				s-=_val[k]*u[_col[k]];
+		}
+		u[i]=s/d;
+	}
+	return;
+}
+Vec t=Vec::Zero(_rows); //t[i]: sum of A(j,i)*u[j] over updated j<i, scattered from rows above
+for(int i=0;i<_rows;i++)
+{
+	Real s=f[i]-t[i],d(0);
+	for(int k=_ptr[i];k<_ptr[i+1];k++)
+	{
+		if(_col[k]==i)
+			d=_val[k];
+		else
+			s-=_val[k]*u[_col[k]];
+	}
+	u[i]=s/d;
+	for(int k=_ptr[i];k<_ptr[i+1];k++)
+		if(_col[k]>i)
+			t[_col[k]]+=_val[k]*u[i];
+}
+}
+
+void csr::backward_GS(const Vec& f, Vec& u) const
+{
+Vec t;
+if(_upper) //t[i]: sum of A(j,i)*u[j] over j<i, not updated yet when row i is reached
+{
+	t=Vec::Zero(_rows);
+	for(int i=0;i<_rows;i++)
+		for(int k=_ptr[i];k<_ptr[i+1];k++)
+			if(_col[k]>i)
+				t[_col[k]]+=_val[k]*u[i];
+}
+for(int i=_rows-1;i>=0;i--)
+{
+	Real s=f[i],d(0);
+	if(_upper)
+		s-=t[i];
+	for(int k=_ptr[i];k<_ptr[i+1];k++)
+	{
+		if(_col[k]==i)
+			d=_val[k];
+		else
+			s-=_val[k]*u[_col[k]];
+	}
+	u[i]=s/d;
+}
+}
+
+void csr::swap(csr& A)
+{
+std::swap(_rows,A._rows);
+std::swap(_cols,A._cols);
+std::swap(_upper,A._upper);
+std::swap(_ndiag,A._ndiag);
+_ptr.swap(A._ptr);
+_col.swap(A._col);
+_val.swap(A._val);
+}
+
+size_t csr::bytes() const
+{
+return (_ptr.capacity()+_col.capacity())*sizeof(int)+_val.capacity()*sizeof(Real);
+}
@@ -0,0 +1,182 @@
+/**
+* @file   galerkin.cpp
+* @author Laura Melas <laura.melas@mail.polimi.it>
+* @date   2017
+*
+* This file is part of project "AMG Methods".
+*
+* @brief AMG methods for conforming and discontinuous Galerkin finite element discretizations of the Poisson problem.
+*
+*/
+
+#include "galerkin.h"
+
+galerkin::galerkin(const csr& A, const csr& P, const bool& symmetric, arena* pool) : _tptr(pool), _trow(pool), _tpos(pool), _cptr(pool), _ccol(pool)
+{
+_nc=P.cols();
+_upper=symmetric;
+int n=P.rows();
+const int* pptr=P.outerIndexPtr();
+const int* pcol=P.innerIndexPtr();
+const int* aptr=A.outerIndexPtr();
+const int* acol=A.innerIndexPtr();
+
+//index of the columns of P by counting sort
+_tptr.assign(_nc+1,0);
+for(int k=0;k<pptr[n];k++)
+	++_tptr[pcol[k]+1];
+for(int I=0;I<_nc;I++)
+	_tptr[I+1]+=_tptr[I];
+_trow.resize(_tptr[_nc]);
+_tpos.resize(_tptr[_nc]);
+avector<int> next(_tptr.begin(),_tptr.end()-1,pool);
+for(int i=0;i<n;i++)
+{
+	for(int k=pptr[i];k<pptr[i+1];k++)
+	{
+		_trow[next[pcol[k]]]=i;
+		_tpos[next[pcol[k]]++]=k;
+	}
+}
+
+//symbolic phase: number of nonzeros of each coarse row, then sorted column indices
+_cptr.assign(_nc+1,0);
+for(int pass=0;pass<2;pass++)
+{
+	#pragma omp parallel
+	{
+		avector<int> marker(_nc,-1,pool);
+
+		#pragma omp for schedule(dynamic,64)
+		for(int I=0;I<_nc;I++)
+		{
+			int count(0);
+			for(int t=_tptr[I];t<_tptr[I+1];t++)
+			{
+				int i=_trow[t];
+				for(int a=aptr[i];a<aptr[i+1];a++)
+				{
+					int j=acol[a];
+					for(int q=pptr[j];q<pptr[j+1];q++)
+					{
+						int J=pcol[q];
+						if((!_upper || J>=I) && marker[J]!=I)
+						{
+							marker[J]=I;
+							if(pass==1)
+								_ccol[_cptr[I]+count]=J;
+							++count;
+						}
+					}
+				}
+			}
+			if(pass==0)
+				_cptr[I+1]=count;
+			else
+				sort(_ccol.begin()+_cptr[I],_ccol.begin()+_cptr[I+1]);
+		}
+	}
+	if(pass==0)
+	{
+		for(int I=0;I<_nc;I++)
+			_cptr[I+1]+=_cptr[I];
+		_ccol.resize(_cptr[_nc]);
+	}
+}
+}
+
+void galerkin::product(const csr& A, const csr& P, csr& Ac) const
+{
+const int* pptr=P.outerIndexPtr();
+const int* pcol=P.innerIndexPtr();
+const Real* pval=P.valuePtr();
+const int* aptr=A.outerIndexPtr();
+const int* acol=A.innerIndexPtr();
+const Real* aval=A.valuePtr();
+
+csr C(_nc,_nc);
+C.resizeNonZeros(_cptr[_nc]);
+copy(_cptr.begin(),_cptr.end(),C.outerIndexPtr());
+copy(_ccol.begin(),_ccol.end(),C.innerIndexPtr());
+Real* cval=C.valuePtr();
+
+#pragma omp parallel
+{
+	avector<int> pos(_nc,0,_cptr.get_allocator()); //position of each column in the current coarse row
+
+	#pragma omp for schedule(dynamic,64)
+	for(int I=0;I<_nc;I++)
+	{
+		for(int k=_cptr[I];k<_cptr[I+1];k++)
+		{
+			pos[_ccol[k]]=k;
+			cval[k]=0;
+		}
+		for(int t=_tptr[I];t<_tptr[I+1];t++) //row I of P^T*A*P is the sum of P(i,I)*A(i,:)*P
+		{
+			int i=_trow[t];
+			Real p=pval[_tpos[t]];
+			for(int a=aptr[i];a<aptr[i+1];a++)
+			{
+				int j=acol[a];
+				Real pa=p*aval[a];
+				for(int q=pptr[j];q<pptr[j+1];q++)
+				{
+					int J=pcol[q];
+					if(!_upper || J>=I)
+						cval[pos[J]]+=pa*pval[q];
+				}
+			}
+		}
+	}
+}
+
+if(_upper)
+	mirror(C,Ac);
+else
+	Ac.swap(C);
+}
+
+void galerkin::mirror(const csr& U, csr& Ac)
+{
+int n=U.rows();
+const int* uptr=U.outerIndexPtr();
+const int* ucol=U.innerIndexPtr();
+const Real* uval=U.valuePtr();
+
+Ac.resize(n,n);
+int* ptr=Ac.outerIndexPtr();
+for(int I=0;I<n;I++) //row I gets its upper part and the strictly upper part of column I
+{
+	ptr[I+1]+=uptr[I+1]-uptr[I];
+	for(int k=uptr[I];k<uptr[I+1];k++)
+		if(ucol[k]>I)
+			++ptr[ucol[k]+1];
+}
+for(int I=0;I<n;I++)
+	ptr[I+1]+=ptr[I];
+Ac.resizeNonZeros(ptr[n]);
+int* col=Ac.innerIndexPtr();
+Real* val=Ac.valuePtr();
+
+vector<int> next(ptr,ptr+n);
+for(int I=0;I<n;I++) //lower entries of row J come from rows I<J, so each row stays sorted
+{
+	for(int k=uptr[I];k<uptr[I+1];k++)
+	{
+		int J=ucol[k];
+		col[next[I]]=J;
+		val[next[I]++]=uval[k];
+		if(J>I)
+		{
+			col[next[J]]=I;
+			val[next[J]++]=uval[k];
+		}
+	}
+}
+}
+
+size_t galerkin::bytes() const
+{
+return (_tptr.capacity()+_trow.capacity()+_tpos.capacity()+_cptr.capacity()+_ccol.capacity())*sizeof(int);
+}
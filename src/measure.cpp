@@ -0,0 +1,114 @@
+/**
+* @file   measure.cpp
+* @author Laura Melas <laura.melas@mail.polimi.it>
+* @date   2017
+*
+* This file is part of project "AMG Methods".
+*
+* @brief AMG methods for conforming and discontinuous Galerkin finite element discretizations of the Poisson problem.
+*
+*/
+
+#include "measure.h"
+
+measure::measure(const vector<int>& lambda) : _lambda(lambda), _top(-1)
+{
+for(size_t i=0;i<_lambda.size();i++)
+{
+	insert(i,_lambda[i]);
+	_top=max(_top,_lambda[i]);
+}
+}
+
+void measure::insert(const int& i, const int& b)
+{
+if(b>=int(_bucket.size()))
+	_bucket.resize(b+1);
+vector<vector<uint64_t> >& B=_bucket[b];
+if(B.empty()) //allocation of the bitmap levels at first use of the bucket
+{
+	size_t words=_lambda.size();
+	do
+	{
+		words=(words+63)/64;
+		B.push_back(vector<uint64_t>(words,0));
+	}
+	while(words>1);
+}
+
+size_t p=i;
+for(size_t l=0;l<B.size();l++)
+{
+	uint64_t& word=B[l][p/64];
+	bool was_empty=(word==0);
+	word|=uint64_t(1)<<(p%64);
+	if(!was_empty)
+		break;
+	p/=64;
+}
+}
+
+void measure::erase(const int& i, const int& b)
+{
+vector<vector<uint64_t> >& B=_bucket[b];
+size_t p=i;
+for(size_t l=0;l<B.size();l++)
+{
+	uint64_t& word=B[l][p/64];
+	word&=~(uint64_t(1)<<(p%64));
+	if(word!=0)
+		break;
+	p/=64;
+}
+}
+
+bool measure::empty_bucket(const int& b) const
+{
+return b>=int(_bucket.size()) || _bucket[b].empty() || _bucket[b].back()[0]==0;
+}
+
+void measure::increment(const int& i)
+{
+erase(i,_lambda[i]);
+++_lambda[i];
+insert(i,_lambda[i]);
+_top=max(_top,_lambda[i]);
+}
+
+void measure::decrement(const int& i)
+{
+if(_lambda[i]>0)
+{
+	erase(i,_lambda[i]);
+	--_lambda[i];
+	insert(i,_lambda[i]);
+}
+}
+
+void measure::remove(const int& i)
+{
+if(_lambda[i]>=0)
+{
+	erase(i,_lambda[i]);
+	_lambda[i]=-1;
+}
+}
+
+int measure::top()
+{
+while(_top>=0 && empty_bucket(_top))
+	--_top;
+if(_top<0)
+	return -1;
+
+const vector<vector<uint64_t> >& B=_bucket[_top];
+size_t p=0;
+for(size_t l=B.size();l-->0;) //descend the bitmap levels following the first non-zero bit
+	p=64*p+__builtin_ctzll(B[l][p]);
+return p;
+}
+
+bool measure::isEmpty()
+{
+return top()==-1;
+}
@@ -11,7 +11,7 @@
 
 #include "output.h"
 
-output::output(const string& testname,const string& inputA, const string& inputf, const string& fem, const string& method, const int& iter,const Real& rho, const bool& flag, const parameter_setup& ps, const parameter_cycle& pc, const parameter_method& pm)
+output::output(const string& testname,const string& inputA, const string& inputf, const string& fem, const string& method, const int& iter,const Real& rho, const bool& flag, const int& levels, const Real& complexity, const size_t& hierarchy_bytes, const size_t& peak_bytes, const Real& spectral_radius, const parameter_setup& ps, const parameter_cycle& pc, const parameter_method& pm)
 {
 _testname=testname;
 _inputA=inputA;
@@ -21,6 +21,11 @@ _method=method;
 _iter=iter;
 _rho=rho;
 _flag=flag;
+_levels=levels;
+_complexity=complexity;
+_hierarchy_bytes=hierarchy_bytes;
+_peak_bytes=peak_bytes;
+_spectral_radius=spectral_radius;
 _ps=ps;
 _pc=pc;
 _pm=pm;
@@ -36,6 +41,34 @@ cout<<endl;
 cout<<"PARAMETERS"<<endl;
 cout<<"nmatrix = "<<_ps.get_nmatrix()+1<<endl;
 cout<<"theta = "<<_ps.get_theta()<<endl;
+cout<<"coarsening = "<<_ps.get_coarsening()<<endl;
+if(_ps.get_coarsening()!="RS" || _ps.get_aggregation()=="MIS" || _ps.get_aggregation_DG()=="MIS")
+	cout<<"seed = "<<_ps.get_seed()<<endl;
+if(_ps.get_trunc_factor()>0)
+	cout<<"trunc_factor = "<<_ps.get_trunc_factor()<<endl;
+if(_ps.get_max_elements()>0)
+	cout<<"max_elements = "<<_ps.get_max_elements()<<endl;
+if(_ps.get_aggressive_levels()>0)
+	cout<<"aggressive_levels = "<<_ps.get_aggressive_levels()<<endl;
+if(_ps.get_max_coarse_size()>0)
+	cout<<"max_coarse_size = "<<_ps.get_max_coarse_size()<<endl;
+if(_ps.get_max_coarse_ratio()<1)
+	cout<<"max_coarse_ratio = "<<_ps.get_max_coarse_ratio()<<endl;
+if(_ps.get_half_storage())
+	cout<<"half_storage = "<<_ps.get_half_storage()<<endl;
+if(_ps.get_hierarchy()!="classical")
+	cout<<"hierarchy = "<<_ps.get_hierarchy()<<endl;
+if(_ps.get_aggregation()!="standard")
+	cout<<"aggregation = "<<_ps.get_aggregation()<<endl;
+if(_ps.get_aggregation()=="matching")
+	cout<<"aggregation_ratio = "<<_ps.get_aggregation_ratio()<<endl;
+if(_ps.get_aggregation_DG()!="pairwise")
+{
+	cout<<"aggregation_DG = "<<_ps.get_aggregation_DG()<<endl;
+	cout<<"theta_DG = "<<_ps.get_theta_DG()<<endl;
+}
+if(_ps.get_omega()>0)
+	cout<<"omega = "<<_ps.get_omega()<<endl;
 cout<<"nlevel = "<<_pc.get_nlevel()+1<<endl;
 cout<<"nu1 = "<<_pc.get_nu1()<<endl;
 cout<<"nu2 = "<<_pc.get_nu2()<<endl;
@@ -46,6 +79,12 @@ cout<<"fem = "<<_fem<<endl;
 cout<<"method = "<<_method<<endl;
 cout<<endl;
 cout<<"RESULTS"<<endl;
+cout<<"Number of levels = "<<_levels<<endl;
+cout<<"Operator complexity = "<<_complexity<<endl;
+cout<<"Hierarchy memory = "<<_hierarchy_bytes<<" bytes"<<endl;
+cout<<"Setup peak memory = "<<_peak_bytes<<" bytes"<<endl;
+if(_spectral_radius>0)
+	cout<<"Spectral radius of D^-1*A = "<<_spectral_radius<<endl;
 if(_flag==1)
 	cout<<"Method not convergent"<<endl;
 else
@@ -66,6 +105,34 @@ myfile<<endl;
 myfile<<"PARAMETERS"<<endl;
 myfile<<"nmatrix = "<<_ps.get_nmatrix()+1<<endl;
 myfile<<"theta = "<<_ps.get_theta()<<endl;
+myfile<<"coarsening = "<<_ps.get_coarsening()<<endl;
+if(_ps.get_coarsening()!="RS" || _ps.get_aggregation()=="MIS" || _ps.get_aggregation_DG()=="MIS")
+	myfile<<"seed = "<<_ps.get_seed()<<endl;
+if(_ps.get_trunc_factor()>0)
+	myfile<<"trunc_factor = "<<_ps.get_trunc_factor()<<endl;
+if(_ps.get_max_elements()>0)
+	myfile<<"max_elements = "<<_ps.get_max_elements()<<endl;
+if(_ps.get_aggressive_levels()>0)
+	myfile<<"aggressive_levels = "<<_ps.get_aggressive_levels()<<endl;
+if(_ps.get_max_coarse_size()>0)
+	myfile<<"max_coarse_size = "<<_ps.get_max_coarse_size()<<endl;
+if(_ps.get_max_coarse_ratio()<1)
+	myfile<<"max_coarse_ratio = "<<_ps.get_max_coarse_ratio()<<endl;
+if(_ps.get_half_storage())
+	myfile<<"half_storage = "<<_ps.get_half_storage()<<endl;
+if(_ps.get_hierarchy()!="classical")
+	myfile<<"hierarchy = "<<_ps.get_hierarchy()<<endl;
+if(_ps.get_aggregation()!="standard")
+	myfile<<"aggregation = "<<_ps.get_aggregation()<<endl;
+if(_ps.get_aggregation()=="matching")
+	myfile<<"aggregation_ratio = "<<_ps.get_aggregation_ratio()<<endl;
+if(_ps.get_aggregation_DG()!="pairwise")
+{
+	myfile<<"aggregation_DG = "<<_ps.get_aggregation_DG()<<endl;
+	myfile<<"theta_DG = "<<_ps.get_theta_DG()<<endl;
+}
+if(_ps.get_omega()>0)
+	myfile<<"omega = "<<_ps.get_omega()<<endl;
 myfile<<"nlevel = "<<_pc.get_nlevel()+1<<endl;
 myfile<<"nu1 = "<<_pc.get_nu1()<<endl;
 myfile<<"nu2 = "<<_pc.get_nu2()<<endl;
@@ -76,6 +143,12 @@ myfile<<"fem = "<<_fem<<endl;
 myfile<<"method = "<<_method<<endl;
 myfile<<endl;
 myfile<<"RESULTS"<<endl;
+myfile<<"Number of levels = "<<_levels<<endl;
+myfile<<"Operator complexity = "<<_complexity<<endl;
+myfile<<"Hierarchy memory = "<<_hierarchy_bytes<<" bytes"<<endl;
+myfile<<"Setup peak memory = "<<_peak_bytes<<" bytes"<<endl;
+if(_spectral_radius>0)
+	myfile<<"Spectral radius of D^-1*A = "<<_spectral_radius<<endl;
 if(_flag==1)
 	myfile<<"Method not convergent"<<endl;
 else
@@ -11,10 +11,24 @@
 
 #include "parameter_setup.h"
 
-parameter_setup::parameter_setup(const int& nmatrix,const Real& theta)
+parameter_setup::parameter_setup(const int& nmatrix,const Real& theta,const string& coarsening,const int& seed,const Real& trunc_factor,const int& max_elements,const int& aggressive_levels,const int& max_coarse_size,const Real& max_coarse_ratio,const bool& half_storage,const Real& omega,const string& hierarchy,const string& aggregation,const Real& aggregation_ratio,const string& aggregation_DG,const Real& theta_DG)
 {
 _nmatrix=nmatrix;
 _theta=theta;
+_coarsening=coarsening;
+_seed=seed;
+_trunc_factor=trunc_factor;
+_max_elements=max_elements;
+_aggressive_levels=aggressive_levels;
+_max_coarse_size=max_coarse_size;
+_max_coarse_ratio=max_coarse_ratio;
+_half_storage=half_storage;
+_omega=omega;
+_hierarchy=hierarchy;
+_aggregation=aggregation;
+_aggregation_ratio=aggregation_ratio;
+_aggregation_DG=aggregation_DG;
+_theta_DG=theta_DG;
 }
 
 
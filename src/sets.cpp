@@ -11,73 +11,161 @@
 
 #include "sets.h"
 
-sets::sets(const size_t& dim):_set(dim) {}
+sets::sets(const size_t& n, arena* pool) : _set(pool), _n(n), _bits(pool) {}
 
-sets::sets(const sets& A) : _set(A._set) {}
+sets::sets(const sets& A) : _set(A._set), _n(A._n), _bits(A._bits) {}
 
-bool sets::isMember(const int& s)
+void sets::update_bitmap()
 {
+if(_n==0)
+	return;
+if(_bits.empty() && 32*_set.size()>=_n) //4 bytes of each element against n/8 bytes of the bitmap
+{
+	_bits.assign((_n+63)/64,0);
+	for(size_t j=0;j<_set.size();j++)
+		_bits[_set[j]/64]|=uint64_t(1)<<(_set[j]%64);
+}
+else if(!_bits.empty() && 64*_set.size()<_n)
+	avector<uint64_t>(_bits.get_allocator()).swap(_bits);
+}
+
+bool sets::isMember(const int& s) const
+{
+if(!_bits.empty())
+	return s>=0 && size_t(s)<_n && (_bits[s/64]>>(s%64) & 1);
 return binary_search(_set.begin(),_set.end(),s);
 }
 
-int sets::cardinality()
+int sets::cardinality() const
 {
 return _set.size();
 }
 
 void sets::addElement(const int& s)
 {
-_set.push_back(s);
+if(_set.empty() || _set.back()<s)
+	_set.push_back(s);
+else
+{
+	auto it=lower_bound(_set.begin(),_set.end(),s);
+	if(*it==s)
+		return;
+	_set.insert(it,s);
+}
+if(!_bits.empty())
+	_bits[s/64]|=uint64_t(1)<<(s%64);
+else
+	update_bitmap();
 }
 
-int sets::find_pos_set(const int& s)
+int sets::find_pos_set(const int& s) const
 {
-auto it=find(_set.begin(),_set.end(),s);
-int d=distance(_set.begin(),it);
-return d;
+auto it=lower_bound(_set.begin(),_set.end(),s);
+if(it==_set.end() || *it!=s)
+	return _set.size();
+return distance(_set.begin(),it);
 }
 
 void sets::deleteElement(const int& s)
 {
-_set.erase(find(_set.begin(),_set.end(),s));
-}
-
-void sets::sort_set()
+auto it=lower_bound(_set.begin(),_set.end(),s);
+if(it==_set.end() || *it!=s)
+	return;
+_set.erase(it);
+if(!_bits.empty())
 {
-sort(_set.begin(),_set.end());
+	_bits[s/64]&=~(uint64_t(1)<<(s%64));
+	update_bitmap();
+}
 }
 
-sets sets::union_set(sets& A,sets& B)
+void sets::union_set(const sets& A,const sets& B,sets& U)
 {
-sets U(A.cardinality()+B.cardinality());
-A.sort_set();
-B.sort_set();
+U._set.resize(A.cardinality()+B.cardinality());
 auto it=set_union((A._set).begin(),(A._set).end(),(B._set).begin(),(B._set).end(),(U._set).begin());
-(U._set).resize(it-(U._set).begin());;
-return U;
+(U._set).resize(it-(U._set).begin());
+U._n=max(A._n,B._n);
+U._bits.clear();
+U.update_bitmap();
 }
 
-sets sets::diff_set(sets& A,sets& B)
+void sets::diff_set(const sets& A,const sets& B,sets& D)
 {
-sets D(A.cardinality()+B.cardinality());
-A.sort_set();
-B.sort_set();
+D._set.resize(A.cardinality());
 auto it=set_difference((A._set).begin(),(A._set).end(),(B._set).begin(),(B._set).end(),(D._set).begin());
 (D._set).resize(it-(D._set).begin());
-return D;
+D._n=A._n;
+D._bits.clear();
+D.update_bitmap();
 }
 
-sets sets::inter_set(sets& A,sets& B)
+void sets::inter_set(const sets& A,const sets& B,sets& I)
 {
-sets I(A.cardinality()+B.cardinality());
-A.sort_set();
-B.sort_set();
+I._set.resize(min(A.cardinality(),B.cardinality()));
 auto it=set_intersection((A._set).begin(),(A._set).end(),(B._set).begin(),(B._set).end(),(I._set).begin());
 (I._set).resize(it-(I._set).begin());
-return I;
+I._n=max(A._n,B._n);
+I._bits.clear();
+I.update_bitmap();
+}
+
+void sets::union_with(const sets& B,sets& buffer)
+{
+union_set(*this,B,buffer);
+_set.swap(buffer._set);
+_n=buffer._n;
+_bits.swap(buffer._bits);
 }
 
-bool sets::isEmpty()
+void sets::diff_with(const sets& B)
+{
+size_t m(0),q(0);
+for(size_t j=0;j<_set.size();j++) //the result is written over the set
+{
+	int s=_set[j];
+	bool inB;
+	if(!B._bits.empty()) //constant time membership in B
+		inB=B.isMember(s);
+	else //merge of sorted elements
+	{
+		while(q<B._set.size() && B._set[q]<s)
+			q++;
+		inB=(q<B._set.size() && B._set[q]==s);
+	}
+	if(!inB)
+		_set[m++]=s;
+	else if(!_bits.empty())
+		_bits[s/64]&=~(uint64_t(1)<<(s%64));
+}
+_set.resize(m);
+update_bitmap();
+}
+
+void sets::inter_with(const sets& B)
+{
+size_t m(0),q(0);
+for(size_t j=0;j<_set.size();j++)
+{
+	int s=_set[j];
+	bool inB;
+	if(!B._bits.empty())
+		inB=B.isMember(s);
+	else
+	{
+		while(q<B._set.size() && B._set[q]<s)
+			q++;
+		inB=(q<B._set.size() && B._set[q]==s);
+	}
+	if(inB)
+		_set[m++]=s;
+	else if(!_bits.empty())
+		_bits[s/64]&=~(uint64_t(1)<<(s%64));
+}
+_set.resize(m);
+update_bitmap();
+}
+
+bool sets::isEmpty() const
 {
 return _set.empty();
 }
@@ -85,5 +173,10 @@ return _set.empty();
 void sets::clear_set()
 {
 _set.clear();
+_bits.clear();
 }
 
+size_t sets::bytes() const
+{
+return _set.capacity()*sizeof(int)+_bits.capacity()*sizeof(uint64_t);
+}
@@ -11,296 +11,1525 @@
 
 #include "setup.h"
 #include "sets.h"
+#include "measure.h"
+#include "strength.h"
+#include "galerkin.h"
 
 setup::setup(const SpMat& A,const parameter_setup& p)
 {
 _ps=p;
-_A.reserve(_ps.get_nmatrix());
-_I.reserve(_ps.get_nmatrix()-1);
-_A.push_back(A);
+_A.reserve(_ps.get_nmatrix()+1); //no reallocation of the hierarchy while it grows
+_I.reserve(_ps.get_nmatrix());
+_A.emplace_back(A);
+_symmetric=strength::isSymmetric(A);
 CG_setup();
 }
 
 void setup::CG_setup()
 {
-for(int k=0;k<_ps.get_nmatrix();k++)
+for(int k=0;k<_ps.get_nmatrix() && !isCoarsest(_A[k]);k++)
 {
-	size_t n=_A[k].rows();
-	sets C,F;
-	vector<sets> S(n),St(n),Ci(n),Ds(n),Dw(n);
-	strong_influence_dependence(_A[k],S,St,Dw);
-	colouring_scheme(S,St,C,F);
-	coarse_strong_dependence(S,Ci,Ds,C);
-	check_modify(C,F,Ci,Ds);
-	SpMat I(n,C.cardinality());
-	interpolation(_A[k],I,C,Ci,Ds,Dw);
-	_I.push_back(I);
-	_A.push_back(I.transpose()*_A[k]*I);
+	bool added=(_ps.get_hierarchy()=="SA") ? aggregation_level(k,0) : classical_level(k);
+	if(!added)
+		break;
 }
+finalize();
 }
 
-void setup::strong_influence_dependence(const SpMat& A, vector<sets>& S, vector<sets>& St, vector<sets>& Dw)
+bool setup::classical_level(const int& k)
 {
-vector<Real> maxrow,maxcol;
-minus_maxrow_maxcol(A,maxrow,maxcol);
-for (int k=0; k < A.outerSize(); ++k)
+_pool.reset(); //temporaries of the previous level are all released
+SpMat I;
 {
-	for (SpMat::InnerIterator it(A,k); it; ++it)
+	sets C(_A[k].rows(),&_pool),F(_A[k].rows(),&_pool);
+	adjacency Ci;
+	strength G(_A[k],_ps.get_theta(),_symmetric,&_pool);
+	bool aggressive=(_classical<_ps.get_aggressive_levels());
+	if(aggressive)
+		aggressive_coarsening(G,C,F);
+	else
+		CF_splitting(G,Ci,C,F);
+
+	avector<int> cidx(&_pool);
+	coarse_index(C,_A[k].rows(),cidx);
+	if(aggressive)
+		multipass_interpolation(_A[k],I,C,cidx,G);
+	else
+		interpolation(_A[k],I,C,cidx,Ci,G);
+	track(G.bytes()+Ci.bytes()+C.bytes()+F.bytes()+cidx.capacity()*sizeof(int)+matrix_bytes(I));
+} //temporaries of C/F splitting are released here
+truncation(I);
+if(isStalled(I))
+	return 0;
+add_level(I);
+++_classical;
+return 1;
+}
+
+bool setup::aggregation_level(const int& k, const bool& pairwise)
+{
+_pool.reset(); //temporaries of the previous level are all released
+SpMat I;
+{
+	avector<int> agg(&_pool);
+	int nagg(0);
+	size_t b(0);
+	const string& method=pairwise ? _ps.get_aggregation_DG() : _ps.get_aggregation();
+	if(method=="pairwise")
+		nagg=pairwise_aggregation(k,agg);
+	else if(method=="matching")
+		nagg=matching_aggregation(k,agg);
+	else
 	{
-		if(it.row()!=it.col())
-		{
-			if(abs(it.value())>=_ps.get_theta()*maxrow[it.row()]) //definition of strong dependence set
-			{
-				S[it.row()].addElement(it.col());
-			}
-			else
-			{
-				Dw[it.row()].addElement(it.col());
-			}
-			if(abs(it.value())>=_ps.get_theta()*maxcol[it.col()]) //definition of strong influence set
-			{
-				St[it.row()].addElement(it.col());
-			}
-		}
+		strength G(_A[k],pairwise ? _ps.get_theta_DG() : _ps.get_theta(),_symmetric,&_pool);
+		nagg=(method=="MIS") ? MIS_aggregation(G,agg) : neighbourhood_aggregation(G,agg);
+		b=G.bytes();
 	}
+	unsmoothed_interpolation(k,I,agg,nagg);
+	track(b+agg.capacity()*sizeof(int)+matrix_bytes(I));
+} //aggregates are released here
+GS_orth_interpolation(I);
+smoothed_interpolation(k,I);
+truncation(I);
+if(isStalled(I))
+	return 0;
+add_level(I);
+return 1;
 }
+
+void setup::add_level(SpMat& I)
+{
+_I.emplace_back(I);
+I=SpMat(); //released before the coarse matrix is built
+csr Ac;
+galerkin_product(_A.back(),_I.back(),Ac);
+if(_ps.get_half_storage() && _symmetric) //the fine matrix is not read by setup anymore
+	_A.back().make_upper();
+_A.push_back(csr());
+_A.back().swap(Ac);
+track(0);
 }
 
-void setup::minus_maxrow_maxcol(const SpMat& A,vector<Real>& maxrow, vector<Real>& maxcol)
+void setup::track(const size_t& temporary)
 {
-int dim=A.rows();
-Vec r;
-for(int i=0;i<dim;i++)
+_peak=max(_peak,hierarchy_bytes()+temporary);
+}
+
+size_t setup::matrix_bytes(const SpMat& A)
+{
+size_t b=A.data().allocatedSize()*(sizeof(Real)+sizeof(int))+(A.outerSize()+1)*sizeof(int);
+if(!A.isCompressed())
+	b+=A.outerSize()*sizeof(int);
+return b;
+}
+
+void setup::finalize()
+{
+_pool.release();
+if(_ps.get_half_storage() && _symmetric)
+	_A.back().make_upper();
+}
+
+size_t setup::hierarchy_bytes() const
 {
-	r=(A.row(i)).cwiseAbs();
-	r[i]=0;
-	maxrow.push_back(r.maxCoeff());
-	r=(A.col(i)).cwiseAbs();
-	r[i]=0;
-	maxcol.push_back(r.maxCoeff());
+size_t b(0);
+for(size_t k=0;k<_A.size();k++)
+	b+=_A[k].bytes();
+for(size_t k=0;k<_I.size();k++)
+	b+=_I[k].bytes();
+return b;
 }
+
+void setup::coarse_index(const sets& C, const int& n, avector<int>& cidx)
+{
+cidx.assign(n,-1);
+#pragma omp parallel for schedule(static)
+for(int j=0;j<C.cardinality();j++)
+	cidx[C[j]]=j;
+}
+
+bool setup::isCoarsest(const csr& A) const
+{
+return A.rows()<=_ps.get_max_coarse_size();
+}
+
+bool setup::isStalled(const SpMat& I) const
+{
+return I.cols()==0 || I.cols()>_ps.get_max_coarse_ratio()*I.rows();
+}
+
+Real setup::operator_complexity() const
+{
+Real nnz(0);
+for(size_t k=0;k<_A.size();k++)
+	nnz+=_A[k].entries();
+return nnz/_A[0].entries();
+}
+
+void setup::galerkin_product(const csr& A, const csr& I, csr& Ac)
+{
+galerkin R(A,I,_symmetric,&_pool); //symbolic phase
+R.product(A,I,Ac); //numeric phase
+track(R.bytes()+Ac.bytes());
 }
 
-void setup::colouring_scheme(vector<sets>& S, vector<sets>& St, sets& C, sets& F)
+void setup::colouring_scheme(const strength& G, sets& C, sets& F)
 {
-int n,m,p;
-size_t I;
-vector<int> lambda;
-for(size_t i=0;i<St.size();i++)
+int N=G.size();
+avector<int> cf(N,0,&_pool); //state of points: 1 C-point, -1 F-point, 0 undecided
+first_pass(G,cf,0,N,0);
+
+for(int i=0;i<N;i++)
 {
-	lambda.push_back(St[i].cardinality()); //measure lambda
+	if(cf[i]==1)
+		C.addElement(i);
+	else
+		F.addElement(i);
 }
-sets newF,U,J;
-while(*max_element(lambda.begin(),lambda.end())!=-1)
+}
+
+void setup::first_pass(const strength& G, avector<int>& cf, const int& first, const int& last, const bool& hybrid)
 {
-	I=distance(lambda.begin(),max_element(lambda.begin(),lambda.end())); //new C point
-	C.addElement(I);
-	newF=St[I]; 
-	U=sets::union_set(C,F);
-	newF=sets::diff_set(newF,U); //new F points
-	n=newF.cardinality();
-	for(int i=0;i<n;i++)
+vector<int> lambda(last-first);
+for(int i=first;i<last;i++)
+{
+	for(int k=G.St_begin(i);k<G.St_end(i);k++)
 	{
-		F.addElement(newF[i]);
+		if(G.St_col(k)>=first && G.St_col(k)<last)
+			++lambda[i-first]; //measure lambda
 	}
-	U=sets::union_set(C,F);
-	m=U.cardinality();
-	for(int i=0;i<m;i++) //update lambda
+}
+measure M(lambda);
+avector<int> newF(&_pool);
+while(!M.isEmpty())
+{
+	int I=M.top()+first; //new C point
+	if(hybrid && M[I-first]==0) //remaining points are left to the parallel step
+		break;
+	cf[I]=1;
+	M.remove(I-first);
+	newF.clear();
+	for(int k=G.St_begin(I);k<G.St_end(I);k++) //new F points
 	{
-		lambda[U[i]]=-1;
+		int j=G.St_col(k);
+		if(j>=first && j<last && cf[j]==0)
+		{
+			cf[j]=-1;
+			M.remove(j-first);
+			newF.push_back(j);
+		}
 	}
-	for(int i=0;i<n;i++)
+	for(size_t i=0;i<newF.size();i++) //update lambda
 	{
-		J=S[newF[i]];
-		J=sets::diff_set(J,U);
-		p=J.cardinality();
-		for(int j=0;j<p;j++)
+		for(int k=G.row_begin(newF[i]);k<G.row_end(newF[i]);k++)
 		{
-			++lambda[J[j]];
+			int j=G.col(k);
+			if(G.isStrong(k) && j>=first && j<last && cf[j]==0)
+				M.increment(j-first);
 		}
 	}
 }
+}
 
-C.sort_set();
-F.sort_set();
+//random weight in [0,1) depending only on seed and point (splitmix64 hash), so that PMIS does not depend on thread scheduling
+static Real random_weight(const int& seed, const int& i)
+{
+uint64_t z=(uint64_t(seed)<<32)+uint64_t(i)+0x9e3779b97f4a7c15ULL;
+z=(z^(z>>30))*0xbf58476d1ce4e5b9ULL;
+z=(z^(z>>27))*0x94d049bb133111ebULL;
+z=z^(z>>31);
+return (z>>11)*(1./9007199254740992.);
 }
 
-void setup::coarse_strong_dependence(vector<sets>& S, vector<sets>& Ci, vector<sets>& Ds, sets C)
+//call of f on each neighbour of point i in the symmetrized strength graph (strong dependences and strong influences)
+template<class F>
+static void neighbours(const strength& G, const int& i, F f)
 {
-int n=S.size();
-int m;
-for(int i=0;i<n;i++)
+for(int k=G.row_begin(i);k<G.row_end(i);k++)
+	if(G.isStrong(k))
+		f(G.col(k));
+for(int k=G.St_begin(i);k<G.St_end(i);k++)
+	f(G.St_col(k));
+}
+
+Real setup::spectral_radius(const csr& A, const int& steps) const
+{
+int N=A.rows();
+Vec s(N); //D^-1/2
+for(int i=0;i<N;i++)
+	s[i]=1/sqrt(A.coeff(i,i));
+
+Vec v(N),vold=Vec::Zero(N),w;
+for(int i=0;i<N;i++)
+	v[i]=random_weight(_ps.get_seed(),i)-0.5;
+v.normalize();
+Vec alpha(steps),beta(steps);
+int m(0);
+while(m<steps)
+{
+	w=s.cwiseProduct(A*s.cwiseProduct(v));
+	alpha[m]=w.dot(v);
+	w-=alpha[m]*v+(m>0 ? beta[m-1] : 0)*vold;
+	beta[m]=w.norm();
+	++m;
+	if(beta[m-1]<=1e-12*abs(alpha[m-1])) //invariant subspace found, Ritz values are exact
+		break;
+	vold.swap(v);
+	v=w/beta[m-1];
+}
+
+SelfAdjointEigenSolver<MatrixXd> T; //eigenvalues of the tridiagonal Lanczos matrix
+T.computeFromTridiagonal(alpha.head(m),beta.head(max(m-1,0)),EigenvaluesOnly);
+return T.eigenvalues().maxCoeff();
+}
+
+void setup::independent_set(const strength& G, avector<int>& cf)
+{
+int N=G.size();
+avector<Real> w(N,0,&_pool);
+avector<int> next(cf);
+
+#pragma omp parallel for schedule(static)
+for(int i=0;i<N;i++)
+{
+	w[i]=G.St_cardinality(i)+random_weight(_ps.get_seed(),i); //measure plus random weight
+	if(cf[i]==0 && G.St_cardinality(i)==0) //points without strong influence are F-points
+		next[i]=-1;
+}
+cf.swap(next);
+
+int undecided(1);
+while(undecided>0)
 {
-	m=S[i].cardinality();
-	for(int j=0;j<m;j++) //definition of coarse interpolatory set and strong non-interpolatory set
+	undecided=0;
+	#pragma omp parallel for schedule(static) reduction(+:undecided)
+	for(int i=0;i<N;i++) //undecided points depending on C-points become F-points
 	{
-		if(C.isMember(S[i][j]))
-			Ci[i].addElement(S[i][j]);
-		else
-			Ds[i].addElement(S[i][j]);
+		next[i]=cf[i];
+		if(cf[i]==0)
+		{
+			for(int k=G.row_begin(i);k<G.row_end(i) && next[i]==0;k++)
+			{
+				if(G.isStrong(k) && cf[G.col(k)]==1)
+					next[i]=-1;
+			}
+			if(next[i]==0)
+				++undecided;
+		}
 	}
+	cf.swap(next);
+	if(undecided==0)
+		break;
+
+	#pragma omp parallel for schedule(static)
+	for(int i=0;i<N;i++) //undecided points with maximum weight among undecided neighbours become C-points
+	{
+		next[i]=cf[i];
+		if(cf[i]==0 && is_local_max(G,w,cf,i,0))
+			next[i]=1;
+	}
+	cf.swap(next);
+}
+}
+
+bool setup::is_local_max(const strength& G, const avector<Real>& w, const avector<int>& state, const int& i, const int& s)
+{
+for(int k=G.row_begin(i);k<G.row_end(i);k++)
+{
+	int j=G.col(k);
+	if(G.isStrong(k) && state[j]==s && (w[j]>w[i] || (w[j]==w[i] && j>i)))
+		return 0;
 }
+for(int k=G.St_begin(i);k<G.St_end(i);k++)
+{
+	int j=G.St_col(k);
+	if(state[j]==s && (w[j]>w[i] || (w[j]==w[i] && j>i)))
+		return 0;
+}
+return 1;
 }
 
-void setup::check_modify(sets& C, sets& F, vector<sets>& Ci, vector<sets>& Ds)
+void setup::parallel_second_pass(const strength& G, avector<int>& cf)
 {
-size_t n=F.cardinality();
-size_t all=Ci.size();
-size_t m;
-bool b;
+int N=G.size();
+avector<Real> w(N,0,&_pool);
+avector<int> promote(N,0,&_pool);
 
-for(size_t i=0;i<n;i++)
+#pragma omp parallel for schedule(static)
+for(int i=0;i<N;i++)
+	w[i]=G.St_cardinality(i)+random_weight(_ps.get_seed(),i);
+
+int violations(1);
+while(violations>0)
 {
-	m=Ds[F[i]].cardinality();
-	b=0;
-	for(size_t j=0;j<m;j++)
+	violations=0;
+	#pragma omp parallel for schedule(static) reduction(+:violations)
+	for(int i=0;i<N;i++) //F-points with a strong F-neighbour without common C-point are candidates
 	{
-		if((sets::inter_set(Ci[F[i]],Ci[Ds[F[i]][j]])).isEmpty() && b==0) //check if heuristics are satisfied
+		promote[i]=0;
+		if(cf[i]!=-1)
+			continue;
+		for(int k=G.row_begin(i);k<G.row_end(i) && promote[i]==0;k++)
 		{
-			b=1;
-			C.addElement(F[i]);
-			for(size_t k=0;k<all;k++)
+			int j=G.col(k);
+			if(!G.isStrong(k) || cf[j]!=-1)
+				continue;
+			bool common=0;
+			int p=G.row_begin(i),q=G.row_begin(j);
+			while(p<G.row_end(i) && q<G.row_end(j) && !common) //merge of sorted rows i and j looking for a common strong C-point
 			{
-				if(Ds[k].isMember(F[i]))
+				if(G.col(p)<G.col(q))
+					p++;
+				else if(G.col(q)<G.col(p))
+					q++;
+				else
 				{
-					Ci[k].addElement(F[i]);
-					Ds[k].deleteElement(F[i]);
+					common=(G.isStrong(p) && G.isStrong(q) && cf[G.col(p)]==1);
+					p++;
+					q++;
 				}
 			}
+			if(!common)
+				promote[i]=1;
 		}
+		violations+=promote[i];
+	}
+	if(violations==0)
+		break;
+
+	#pragma omp parallel for schedule(static)
+	for(int i=0;i<N;i++) //candidates with maximum weight among candidate neighbours become C-points
+	{
+		if(promote[i]==1 && is_local_max(G,w,promote,i,1))
+			cf[i]=1;
+	}
+}
+}
+
+void setup::parallel_coarsening(const strength& G, sets& C, sets& F)
+{
+int N=G.size();
+avector<int> cf(N,0,&_pool); //state of points: 1 C-point, -1 F-point, 0 undecided
+
+if(_ps.get_coarsening()=="HMIS")
+{
+	int nblock(1);
+#ifdef _OPENMP
+	nblock=omp_get_max_threads();
+#endif
+	#pragma omp parallel for schedule(static,1)
+	for(int b=0;b<nblock;b++) //sequential first pass inside each thread block
+	{
+		first_pass(G,cf,(long(N)*b)/nblock,(long(N)*(b+1))/nblock,1);
 	}
 }
 
-F=sets::diff_set(F,C);
-C.sort_set();
-F.sort_set();
+independent_set(G,cf);
+parallel_second_pass(G,cf);
+
+for(int i=0;i<N;i++)
+{
+	if(cf[i]==1)
+		C.addElement(i);
+	else
+		F.addElement(i);
+}
 }
 
-void setup::interpolation(const SpMat& A, SpMat& I, sets& C, const vector<sets>& Ci, const vector<sets>& Ds, const vector<sets>& Dw)
+void setup::CF_splitting(const strength& G, adjacency& Ci, sets& C, sets& F)
 {
-Real g;
-size_t N=A.rows();
-vector<Trip> elements;
-for(size_t i=0;i<N;i++)
+if(_ps.get_coarsening()=="RS")
 {
-	if(C.isMember(i))
+	colouring_scheme(G,C,F);
+	check_modify(G,C,F);
+}
+else
+	parallel_coarsening(G,C,F);
+coarse_strong_dependence(G,Ci,C);
+}
+
+void setup::aggressive_coarsening(const strength& G, sets& C, sets& F)
+{
+int N=G.size();
+sets C1(N,&_pool),F1(N,&_pool);
+if(_ps.get_coarsening()=="RS")
+	colouring_scheme(G,C1,F1);
+else
+	parallel_coarsening(G,C1,F1);
+
+int n1=C1.cardinality();
+avector<int> cidx(&_pool); //position of first-stage C-points
+coarse_index(C1,N,cidx);
+
+csr D(n1,n1); //strong paths of length 1 or 2 between first-stage C-points
+int* ptr=D.outerIndexPtr();
+for(int pass=0;pass<2;pass++)
+{
+	#pragma omp parallel
+	{
+		avector<int> marker(n1,-1,&_pool);
+
+		#pragma omp for schedule(dynamic,256)
+		for(int r=0;r<n1;r++)
+		{
+			int i=C1[r],count(0);
+			marker[r]=r;
+			auto visit=[&](const int& c)
+			{
+				if(c>=0 && marker[c]!=r)
+				{
+					marker[c]=r;
+					if(pass==1)
+						D.innerIndexPtr()[ptr[r]+count]=c;
+					++count;
+				}
+			};
+			for(int k=G.row_begin(i);k<G.row_end(i);k++)
+			{
+				if(!G.isStrong(k))
+					continue;
+				int m=G.col(k);
+				if(cidx[m]>=0) //strong C-neighbour
+					visit(cidx[m]);
+				else //strong C-neighbours of a strong F-neighbour
+				{
+					for(int l=G.row_begin(m);l<G.row_end(m);l++)
+						if(G.isStrong(l))
+							visit(cidx[G.col(l)]);
+				}
+			}
+			if(pass==0)
+				ptr[r+1]=count;
+			else
+				sort(D.innerIndexPtr()+ptr[r],D.innerIndexPtr()+ptr[r+1]);
+		}
+	}
+	if(pass==0)
 	{
-		size_t pos=C.find_pos_set(i);
-		elements.push_back(Trip(i,pos,1));
+		for(int r=0;r<n1;r++)
+			ptr[r+1]+=ptr[r];
+		D.resizeNonZeros(ptr[n1]);
 	}
-	else //computation of interpolation weigths
+}
+fill(D.valuePtr(),D.valuePtr()+D.nonZeros(),-1.); //all paths are strong dependences, their transpose gives strong influences
+
+strength G2(D,_ps.get_theta(),1,&_pool);
+avector<int> cf(n1,0,&_pool);
+if(_ps.get_coarsening()=="RS")
+	first_pass(G2,cf,0,n1,0);
+else
+{
+	independent_set(G2,cf);
+	for(int j=0;j<n1;j++) //isolated first-stage C-points are kept
+		if(G2.row_begin(j)==G2.row_end(j) && G2.St_cardinality(j)==0)
+			cf[j]=1;
+}
+
+for(int i=0;i<N;i++)
+{
+	if(cidx[i]>=0 && cf[cidx[i]]==1)
+		C.addElement(i);
+	else
+		F.addElement(i);
+}
+}
+
+void setup::coarse_strong_dependence(const strength& G, adjacency& Ci, const sets& C)
+{
+int n=G.size();
+avector<char> isC(n,0,&_pool);
+for(int j=0;j<C.cardinality();j++)
+	isC[C[j]]=1;
+
+Ci=adjacency(n,G.row_end(n-1),&_pool);
+for(int i=0;i<n;i++)
+{
+	for(int k=G.row_begin(i);k<G.row_end(i);k++) //definition of coarse interpolatory set
 	{
-		sets Cii=Ci[i],Dis=Ds[i],Diw=Dw[i];
-		size_t c=Cii.cardinality(),s=Dis.cardinality(),w=Diw.cardinality();
-		Real den=A.coeff(i,i);
-		SpVec X(N),E(N),S(N);
-		SpCount L(N);
+		if(G.isStrong(k) && isC[G.col(k)])
+			Ci.append(G.col(k));
+	}
+	Ci.close_row();
+}
+}
+
+void setup::check_modify(const strength& G, sets& C, sets& F)
+{
+int n=G.size();
+avector<char> isC(n,0,&_pool);
+for(int j=0;j<C.cardinality();j++)
+	isC[C[j]]=1;
 
-		//compute denominator
-		for(size_t n=0;n<w;n++)
+for(int t=0;t<F.cardinality();t++)
+{
+	int f=F[t];
+	for(int k=G.row_begin(f);k<G.row_end(f) && !isC[f];k++)
+	{
+		int j=G.col(k);
+		if(!G.isStrong(k) || isC[j]) //j in Ds_f
+			continue;
+		bool common=0;
+		int p=G.row_begin(f),q=G.row_begin(j);
+		while(p<G.row_end(f) && q<G.row_end(j) && !common) //merge of sorted rows f and j looking for a common point of Ci_f and Ci_j
 		{
-			Real sum(0),sumabs(0);
-			vector<Real> Aeval=element_set(A,Cii,Diw[n]);
-			for(auto it=Aeval.begin();it != Aeval.end(); ++it)
+			if(G.col(p)<G.col(q))
+				p++;
+			else if(G.col(q)<G.col(p))
+				q++;
+			else
 			{
-				sum+=*it;
-				sumabs+=abs(*it);
+				common=(G.isStrong(p) && G.isStrong(q) && isC[G.col(p)]);
+				p++;
+				q++;
 			}
-			L.insert(Diw[n])=Aeval.size();
-			X.insert(Diw[n])=-sum/sumabs;
-			S.insert(Diw[n])=sumabs;
-			if(L.coeff(Diw[n])==0)
+		}
+		if(!common) //check if heuristics are satisfied
+			isC[f]=1;
+	}
+}
+
+C.clear_set();
+F.clear_set();
+for(int i=0;i<n;i++)
+{
+	if(isC[i])
+		C.addElement(i);
+	else
+		F.addElement(i);
+}
+}
+
+void setup::interpolation(const csr& A, SpMat& I, const sets& C, const avector<int>& cidx, const adjacency& Ci, const strength& G)
+{
+int N=A.rows();
+I.resize(N,C.cardinality());
+int* ptr=I.outerIndexPtr();
+
+#pragma omp parallel for schedule(static)
+for(int i=0;i<N;i++) //number of nonzeros of each row
+{
+	ptr[i+1]=(cidx[i]>=0) ? 1 : Ci.cardinality(i);
+}
+for(int i=0;i<N;i++)
+	ptr[i+1]+=ptr[i];
+I.resizeNonZeros(ptr[N]);
+int* col=I.innerIndexPtr();
+Real* val=I.valuePtr();
+
+#pragma omp parallel
+{
+	avector<int> marker(N,-1,&_pool); //workspaces of each thread
+	avector<Real> acc(N,0,&_pool);
+
+	#pragma omp for schedule(dynamic,256)
+	for(int i=0;i<N;i++) //rows are written directly in compressed storage
+	{
+		int k=ptr[i];
+		if(cidx[i]>=0)
+		{
+			col[k]=cidx[i];
+			val[k]=1;
+		}
+		else //computation of interpolation weigths
+		{
+			interpolation_weights(A,G,Ci,i,marker,acc);
+			for(int t=Ci.row_begin(i);t<Ci.row_end(i);t++,k++)
 			{
-				den-=abs(A.coeff(i,Diw[n]));
+				col[k]=cidx[Ci.col(t)];
+				val[k]=acc[Ci.col(t)];
 			}
-			else if(X.coeff(Diw[n])>=0.5 && A.coeff(i,Diw[n])<0)
+		}
+	}
+}
+}
+
+void setup::interpolation_weights(const csr& A, const strength& G, const adjacency& Ci, const int& i, avector<int>& marker, avector<Real>& acc)
+{
+const int* ptr=A.outerIndexPtr();
+const int* col=A.innerIndexPtr();
+const Real* val=A.valuePtr();
+for(int t=Ci.row_begin(i);t<Ci.row_end(i);t++)
+	marker[Ci.col(t)]=i; //scatter of coarse interpolatory set
+
+Real den(0);
+for(int k=ptr[i];k<ptr[i+1];k++)
+{
+	if(col[k]==i)
+		den=val[k];
+	else if(marker[col[k]]==i)
+		acc[col[k]]=val[k]; //numerator starts from A(i,j)
+}
+
+for(int pass=0;pass<2;pass++) //weak non-interpolatory set first, then strong non-interpolatory set
+{
+	for(int k=ptr[i];k<ptr[i+1];k++)
+	{
+		int m=col[k];
+		if(pass==0 ? !G.isWeak(k) : (!G.isStrong(k) || marker[m]==i))
+			continue;
+
+		Real aim=val[k],ami(0),sum(0),sumabs(0);
+		int L(0);
+		for(int l=ptr[m];l<ptr[m+1];l++) //row m gives A(m,i) and A(m,Ci_i)
+		{
+			if(col[l]==i)
+				ami=val[l];
+			else if(marker[col[l]]==i && val[l]!=0)
 			{
-				den-=A.coeff(i,Diw[n]);
+				sum+=val[l];
+				sumabs+=abs(val[l]);
+				L++;
 			}
 		}
 
-		for(size_t m=0;m<s;m++)
+		if(pass==1 && L==0) //no connection of m to Ci_i: m is skipped (the former formula gave NaN weights to the whole row)
+			continue;
+
+		//compute denominator and factor of the numerator
+		Real X=-sum/sumabs,factor(1);
+		if(pass==0)
 		{
-			Real sum(0),sumabs(0);
-			vector<Real> Aeval=element_set(A,Cii,Dis[m]);
-			for(auto it=Aeval.begin();it != Aeval.end(); ++it)
+			if(L==0)
 			{
-				sum+=*it;
-				sumabs+=abs(*it);
+				den-=abs(aim);
+				factor=0;
 			}
-			L.insert(Dis[m])=Aeval.size();
-			X.insert(Dis[m])=-sum/sumabs;
-			S.insert(Dis[m])=sumabs;
-			E.insert(Dis[m])=abs(A.coeff(Dis[m],i))*L.coeff(Dis[m])/sumabs;
-			if(E.coeff(Dis[m])<0.75 && X.coeff(Dis[m])>=0.5 && A.coeff(i,Dis[m])<0)
+			else if(X>=0.5 && aim<0)
 			{
-				den-=A.coeff(i,Dis[m]);
+				den-=aim;
+				factor=2;
 			}
-			else if(E.coeff(Dis[m])>2 && X.coeff(Dis[m])>=0.5 && A.coeff(i,Dis[m])<0)
+		}
+		else
+		{
+			Real E=abs(ami)*L/sumabs;
+			if(E<0.75 && X>=0.5 && aim<0)
 			{
-				den+=0.5*A.coeff(i,Dis[m]);
+				den-=aim;
+				factor=2;
+			}
+			else if(E>2 && X>=0.5 && aim<0)
+			{
+				den+=0.5*aim;
+				factor=0.5;
 			}
 		}
 
 		//compute numerator
-		for(size_t j=0;j<c;j++)
+		if(factor!=0)
+		{
+			for(int l=ptr[m];l<ptr[m+1];l++)
+			{
+				if(marker[col[l]]==i)
+				{
+					Real g=abs(val[l])/sumabs;
+					acc[col[l]]+=factor*g*aim;
+				}
+			}
+		}
+	}
+}
+
+for(int t=Ci.row_begin(i);t<Ci.row_end(i);t++)
+	acc[Ci.col(t)]=-acc[Ci.col(t)]/den;
+}
+
+void setup::truncation(SpMat& I)
+{
+const Real tol=_ps.get_trunc_factor();
+const int maxel=_ps.get_max_elements();
+if(tol<=0 && maxel<=0)
+	return;
+
+int N=I.rows();
+const int* ptr=I.outerIndexPtr();
+const int* col=I.innerIndexPtr();
+const Real* val=I.valuePtr();
+avector<char> keep(ptr[N],0,&_pool);
+avector<Real> scalepos(N,1,&_pool),scaleneg(N,1,&_pool); //rescaling of positive and negative kept weights of each row
+SpMat T(N,I.cols());
+int* tptr=T.outerIndexPtr();
+
+#pragma omp parallel
+{
+	avector<int> idx(&_pool); //positions of candidate weights of the current row
+
+	#pragma omp for schedule(dynamic,256)
+	for(int i=0;i<N;i++)
+	{
+		Real maxabs(0),pos(0),neg(0),keptpos(0),keptneg(0);
+		for(int k=ptr[i];k<ptr[i+1];k++)
+		{
+			maxabs=max(maxabs,abs(val[k]));
+			(val[k]>0 ? pos : neg)+=val[k];
+		}
+		idx.clear();
+		for(int k=ptr[i];k<ptr[i+1];k++) //relative drop tolerance
+		{
+			if(abs(val[k])>=tol*maxabs)
+				idx.push_back(k);
+		}
+		if(maxel>0 && int(idx.size())>maxel) //largest weights of the row
+		{
+			nth_element(idx.begin(),idx.begin()+maxel,idx.end(),[&](const int& a,const int& b){return abs(val[a])>abs(val[b]) || (abs(val[a])==abs(val[b]) && a<b);});
+			idx.resize(maxel);
+		}
+		for(size_t j=0;j<idx.size();j++)
+		{
+			keep[idx[j]]=1;
+			(val[idx[j]]>0 ? keptpos : keptneg)+=val[idx[j]];
+		}
+		if(keptpos!=0) //signs are rescaled separately, so that a small sum of mixed-sign weights is not amplified
+			scalepos[i]=pos/keptpos;
+		if(keptneg!=0)
+			scaleneg[i]=neg/keptneg;
+		tptr[i+1]=idx.size();
+	}
+}
+
+for(int i=0;i<N;i++)
+	tptr[i+1]+=tptr[i];
+T.resizeNonZeros(tptr[N]);
+int* tcol=T.innerIndexPtr();
+Real* tval=T.valuePtr();
+
+#pragma omp parallel for schedule(static)
+for(int i=0;i<N;i++) //compaction of kept weights, columns stay sorted
+{
+	int t=tptr[i];
+	for(int k=ptr[i];k<ptr[i+1];k++)
+	{
+		if(keep[k])
 		{
-			Real num=A.coeff(i,Cii[j]);
+			tcol[t]=col[k];
+			tval[t++]=(val[k]>0 ? scalepos[i] : scaleneg[i])*val[k];
+		}
+	}
+}
+
+I.swap(T);
+}
+
+void setup::multipass_interpolation(const csr& A, SpMat& I, const sets& C, const avector<int>& cidx, const strength& G)
+{
+int N=A.rows();
+int nc=C.cardinality();
+const int* aptr=A.outerIndexPtr();
+const int* acol=A.innerIndexPtr();
+const Real* aval=A.valuePtr();
+
+avector<int> pass(N,-1,&_pool),next(N,0,&_pool); //pass of each point: 0 C-points, -1 not reached
+
+#pragma omp parallel for schedule(static)
+for(int i=0;i<N;i++)
+	if(cidx[i]>=0)
+		pass[i]=0;
+int npass(0),added(1);
+while(added>0) //points strongly depending on points of the previous pass
+{
+	added=0;
+	#pragma omp parallel for schedule(static) reduction(+:added)
+	for(int i=0;i<N;i++)
+	{
+		next[i]=pass[i];
+		if(pass[i]!=-1)
+			continue;
+		for(int k=G.row_begin(i);k<G.row_end(i) && next[i]==-1;k++)
+		{
+			if(G.isStrong(k) && pass[G.col(k)]==npass)
+			{
+				next[i]=npass+1;
+				++added;
+			}
+		}
+	}
+	pass.swap(next);
+	if(added>0)
+		++npass;
+}
 
-			for(size_t n=0;n<w;n++)
+//rows of interpolation, pooled in order of passes: row i is rcol[rbeg[i]],...,rcol[rbeg[i]+rlen[i]-1], column indices sorted
+avector<int> rbeg(N,0,&_pool),rlen(N,0,&_pool),rcol(nc,0,&_pool);
+avector<Real> rval(nc,1,&_pool),negw(N,0,&_pool),posw(N,0,&_pool);
+
+#pragma omp parallel for schedule(static)
+for(int i=0;i<N;i++) //the row of a C-point is its own column, stored in position cidx[i]
+{
+	if(cidx[i]>=0)
+	{
+		rbeg[i]=cidx[i];
+		rlen[i]=1;
+		rcol[cidx[i]]=cidx[i];
+	}
+}
+
+#pragma omp parallel
+{
+	avector<int> marker(nc,-1,&_pool); //workspaces of each thread
+	avector<Real> acc(nc,0,&_pool);
+	avector<int> list(&_pool);
+
+	for(int p=1;p<=npass;p++)
+	{
+		#pragma omp for schedule(dynamic,256)
+		for(int i=0;i<N;i++) //scaling of each row and number of its weights
+		{
+			if(pass[i]!=p)
+				continue;
+			Real diag(0),negN(0),posN(0),negD(0),posD(0);
+			for(int k=aptr[i];k<aptr[i+1];k++)
 			{
-				if(L.coeff(Diw[n])>0 && X.coeff(Diw[n])>=0.5 && A.coeff(i,Diw[n])<0)
+				int j=acol[k];
+				if(j==i)
+				{
+					diag=aval[k];
+					continue;
+				}
+				bool D=(G.isStrong(k) && pass[j]>=0 && pass[j]<p);
+				if(aval[k]<0)
 				{
-					g=abs(A.coeff(Diw[n],Cii[j]))/S.coeff(Diw[n]);
-					num+=2*g*A.coeff(i,Diw[n]);
+					negN+=aval[k];
+					negD+=D ? aval[k] : 0;
 				}
-				else if(L.coeff(Diw[n])>0)
+				else
 				{
-					g=abs(A.coeff(Diw[n],Cii[j]))/S.coeff(Diw[n]);
-					num+=g*A.coeff(i,Diw[n]);
+					posN+=aval[k];
+					posD+=D ? aval[k] : 0;
 				}
 			}
+			if(posD==0)
+				diag+=posN;
+			if(diag==0)
+				continue;
+			negw[i]=(negD!=0) ? -negN/negD/diag : 0;
+			posw[i]=(posD!=0) ? -posN/posD/diag : 0;
 
-			for(size_t m=0;m<s;m++)
+			int count(0);
+			for(int k=aptr[i];k<aptr[i+1];k++)
 			{
-				if(E.coeff(Dis[m])<0.75 && X.coeff(Dis[m])>=0.5 && A.coeff(i,Dis[m])<0)
+				int j=acol[k];
+				if(j==i || !G.isStrong(k) || pass[j]<0 || pass[j]>=p)
+					continue;
+				for(int q=rbeg[j];q<rbeg[j]+rlen[j];q++)
 				{
-					g=abs(A.coeff(Dis[m],Cii[j]))/S.coeff(Dis[m]);
-					num+=2*g*A.coeff(i,Dis[m]);
+					if(marker[rcol[q]]!=i)
+					{
+						marker[rcol[q]]=i;
+						++count;
+					}
 				}
-				else if(E.coeff(Dis[m])>2 && X.coeff(Dis[m])>=0.5 && A.coeff(i,Dis[m])<0)
+			}
+			rlen[i]=count;
+		}
+
+		#pragma omp single
+		{
+			size_t size=rcol.size();
+			for(int i=0;i<N;i++)
+			{
+				if(pass[i]==p)
 				{
-					g=abs(A.coeff(Dis[m],Cii[j]))/S.coeff(Dis[m]);
-					num+=0.5*g*A.coeff(i,Dis[m]);
+					rbeg[i]=size;
+					size+=rlen[i];
 				}
-				else
+			}
+			rcol.resize(size);
+			rval.resize(size);
+		}
+
+		#pragma omp for schedule(dynamic,256)
+		for(int i=0;i<N;i++) //combination of rows of interpolation of earlier passes
+		{
+			if(pass[i]!=p || rlen[i]==0)
+				continue;
+			list.clear();
+			for(int k=aptr[i];k<aptr[i+1];k++)
+			{
+				int j=acol[k];
+				if(j==i || !G.isStrong(k) || pass[j]<0 || pass[j]>=p)
+					continue;
+				Real w=(aval[k]<0 ? negw[i] : posw[i])*aval[k];
+				for(int q=rbeg[j];q<rbeg[j]+rlen[j];q++)
 				{
-					g=abs(A.coeff(Dis[m],Cii[j]))/S.coeff(Dis[m]);
-					num+=g*A.coeff(i,Dis[m]);
+					int c=rcol[q];
+					if(marker[c]!=N+i) //markers of the counting sweep are i
+					{
+						marker[c]=N+i;
+						acc[c]=0;
+						list.push_back(c);
+					}
+					acc[c]+=w*rval[q];
 				}
 			}
-			Real wij=-num/den;
-			size_t pos=C.find_pos_set(Cii[j]);
-			elements.push_back(Trip(i,pos,wij));	
+			sort(list.begin(),list.end());
+			for(size_t q=0;q<list.size();q++)
+			{
+				rcol[rbeg[i]+q]=list[q];
+				rval[rbeg[i]+q]=acc[list[q]];
+			}
+		}
+	}
+}
+
+I.resize(N,nc);
+int* ptr=I.outerIndexPtr();
+for(int i=0;i<N;i++)
+	ptr[i+1]=ptr[i]+rlen[i];
+I.resizeNonZeros(ptr[N]);
+
+#pragma omp parallel for schedule(static)
+for(int i=0;i<N;i++)
+{
+	copy(rcol.begin()+rbeg[i],rcol.begin()+rbeg[i]+rlen[i],I.innerIndexPtr()+ptr[i]);
+	copy(rval.begin()+rbeg[i],rval.begin()+rbeg[i]+rlen[i],I.valuePtr()+ptr[i]);
+}
+}
+
+int setup::pairwise_aggregation(const int& k, avector<int>& agg)
+{
+int R=_A[k].rows();
+avector<int> pos(&_pool);
+avector<Real> val(&_pool);
+maxrow_pos(_A[k],pos,val); //initialization
+avector<int> chain(R,-1,&_pool),next(R,-1,&_pool); //members as linked lists: list containing each point, -1 if none
+avector<int> head(&_pool),length(&_pool),label(&_pool); //first member, number of members and aggregate of each list
+avector<int> own(&_pool); //list of each aggregate, -1 for deleted aggregates
+priority_queue<int,vector<int>,greater<int> > freeid; //deleted aggregates, the smallest one is reused first
+
+auto create=[&]() //new aggregate with an empty list
+{
+	int a;
+	if(freeid.empty())
+	{
+		a=own.size();
+		own.push_back(-1);
+	}
+	else
+	{
+		a=freeid.top();
+		freeid.pop();
+	}
+	own[a]=head.size();
+	head.push_back(-1);
+	length.push_back(0);
+	label.push_back(a);
+	return a;
+};
+auto link=[&](const int& L, const int& i)
+{
+	chain[i]=L;
+	next[i]=head[L];
+	head[L]=i;
+	++length[L];
+};
+auto aggregate=[&](const int& i)
+{
+	return (chain[i]==-1) ? -1 : label[chain[i]];
+};
+
+int a=create();
+link(own[a],0);
+if(pos[0]>=0)
+	link(own[a],pos[0]);
+
+for(int i=1;i<R;i++)
+{
+	int N=aggregate(i);
+	if(pos[i]==-1 || val[i]>0) //isolated point or positive strongest connection
+	{
+		if(N==-1) //new candidate singleton aggregate
+			link(own[create()],i);
+	}
+	else
+	{
+		int M=aggregate(pos[i]);
+		if(N==-1 && M==-1)  //new candidate pair aggregate
+		{
+			a=create();
+			link(own[a],i);
+			link(own[a],pos[i]);
+		}
+		else if(N==-1 && M>=0) //enlarging singleton or pair aggregates
+			link(own[M],i);
+		else if(N>=0 && M==-1)
+			link(own[N],pos[i]);
+		else if(N>=0 && M>=0 && M!=N) //the shorter chain is moved to the longer one, which is given the smaller index
+		{
+			int lo=min(N,M),hi=max(N,M);
+			int big=own[lo],small=own[hi];
+			if(length[big]<length[small])
+				swap(big,small);
+			for(int j=head[small];j!=-1;)
+			{
+				int nj=next[j];
+				link(big,j);
+				j=nj;
+			}
+			own[lo]=big;
+			label[big]=lo;
+			own[hi]=-1;
+			freeid.push(hi);
+		}
+	}
+}
+
+agg.resize(R);
+for(int i=0;i<R;i++)
+	agg[i]=aggregate(i);
+int nagg(0);
+if(freeid.empty())
+	nagg=own.size();
+else //aggregates left empty are removed, the others keep their order
+{
+	avector<int> id(own.size(),-1,&_pool);
+	for(size_t b=0;b<own.size();b++)
+		if(own[b]!=-1)
+			id[b]=nagg++;
+	for(int i=0;i<R;i++)
+		if(agg[i]>=0)
+			agg[i]=id[agg[i]];
+}
+return nagg;
+}
+
+int setup::neighbourhood_aggregation(const strength& G, avector<int>& agg)
+{
+int N=G.size();
+agg.assign(N,-1);
+int nagg(0);
+
+for(int i=0;i<N;i++) //first pass: points with no aggregated strong neighbour are aggregated with all of them
+{
+	if(agg[i]!=-1)
+		continue;
+	bool unaggregated(1),strong(0);
+	for(int k=G.row_begin(i);k<G.row_end(i) && unaggregated;k++)
+	{
+		if(G.isStrong(k))
+		{
+			strong=1;
+			unaggregated=(agg[G.col(k)]==-1);
+		}
+	}
+	if(!unaggregated || !strong) //isolated points are left out of aggregates
+		continue;
+	agg[i]=nagg;
+	for(int k=G.row_begin(i);k<G.row_end(i);k++)
+		if(G.isStrong(k))
+			agg[G.col(k)]=nagg;
+	++nagg;
+}
+
+avector<int> first(agg); //aggregates of the first pass
+for(int i=0;i<N;i++) //second pass: remaining points join the aggregate of a strong neighbour of the first pass
+{
+	if(agg[i]!=-1)
+		continue;
+	for(int k=G.row_begin(i);k<G.row_end(i);k++)
+	{
+		if(G.isStrong(k) && first[G.col(k)]!=-1)
+		{
+			agg[i]=first[G.col(k)];
+			break;
+		}
+	}
+}
+
+for(int i=0;i<N;i++) //third pass: new aggregates of the points left with their strong neighbours left
+{
+	if(agg[i]!=-1)
+		continue;
+	bool strong(0);
+	for(int k=G.row_begin(i);k<G.row_end(i);k++)
+	{
+		if(G.isStrong(k) && agg[G.col(k)]==-1)
+		{
+			agg[G.col(k)]=nagg;
+			strong=1;
+		}
+	}
+	if(strong)
+		agg[i]=nagg++;
+}
+return nagg;
+}
+
+int setup::pairwise_matching(const csr& A, avector<int>& match, const bool& isolated)
+{
+const Real beta(0.25); //strong negative connections: -A(i,j)>=beta*max(-A(i,k))
+const Real kappa(10); //upper bound on the quality of an accepted pair
+int N=A.rows();
+const int* ptr=A.outerIndexPtr();
+const int* col=A.innerIndexPtr();
+const Real* val=A.valuePtr();
+avector<Real> diag(N,0,&_pool),sneg(N,0,&_pool),maxneg(N,0,&_pool);
+
+#pragma omp parallel for schedule(static)
+for(int i=0;i<N;i++) //diagonal with positive off-diagonal entries lumped, s(i)=-sum of negative off-diagonal entries, largest negative connection
+{
+	Real d(0),s(0),m(0);
+	for(int k=ptr[i];k<ptr[i+1];k++)
+	{
+		if(col[k]==i)
+			d+=val[k];
+		else if(val[k]>0)
+			d-=val[k];
+		else
+		{
+			s-=val[k];
+			m=max(m,-val[k]);
+		}
+	}
+	diag[i]=d;
+	sneg[i]=s;
+	maxneg[i]=m;
+}
+
+auto strong=[&](const int& i, const int& k) //strong negative connection of i in position k of its row
+{
+	return col[k]!=i && val[k]<0 && -val[k]>=beta*maxneg[i];
+};
+auto harmonic=[](const Real& a, const Real& b) //(1/a+1/b)^-1, 0 if a or b is 0
+{
+	return (a>0 && b>0) ? a*b/(a+b) : Real(0);
+};
+
+avector<int> count(N,0,&_pool); //number of unaggregated strong neighbours
+priority_queue<std::pair<int,int>,vector<std::pair<int,int> >,greater<std::pair<int,int> > > order; //points by count, outdated entries are skipped
+for(int i=0;i<N;i++)
+{
+	for(int k=ptr[i];k<ptr[i+1];k++)
+		count[i]+=strong(i,k);
+	if(!isolated || ptr[i+1]-ptr[i]>1) //points with no connection are not aggregated, aggregates with no connection are singletons
+		order.emplace(count[i],i);
+}
+match.assign(N,-1);
+auto mark=[&](const int& i, const int& p) //neighbours of an aggregated point lose a candidate (the pattern is symmetric)
+{
+	match[i]=p;
+	for(int k=ptr[i];k<ptr[i+1];k++)
+	{
+		int j=col[k];
+		if(j!=i && match[j]==-1 && val[k]<0 && -val[k]>=beta*maxneg[j])
+			order.emplace(--count[j],j);
+	}
+};
+
+int np(0);
+while(!order.empty()) //the point with fewest candidates is paired with the one of best quality, or left alone
+{
+	int i=order.top().second;
+	bool outdated=(match[i]!=-1 || order.top().first!=count[i]);
+	order.pop();
+	if(outdated)
+		continue;
+	int best(-1);
+	Real mu(kappa);
+	for(int k=ptr[i];k<ptr[i+1];k++)
+	{
+		int j=col[k];
+		if(!strong(i,k) || match[j]!=-1)
+			continue;
+		Real ti=diag[i]+sneg[i]+2*val[k],tj=diag[j]+sneg[j]+2*val[k];
+		if(ti<=0 || tj<=0)
+			continue;
+		Real den=-val[k]+harmonic(max(diag[i]-sneg[i],Real(0)),max(diag[j]-sneg[j],Real(0)));
+		if(den<=0)
+			continue;
+		Real q=(-val[k]+harmonic(ti,tj))/den;
+		if(q<mu)
+		{
+			mu=q;
+			best=j;
+		}
+	}
+	mark(i,np);
+	if(best>=0)
+		mark(best,np);
+	++np;
+}
+return np;
+}
+
+int setup::matching_aggregation(const int& k, avector<int>& agg)
+{
+int N=_A[k].rows();
+agg.resize(N);
+iota(agg.begin(),agg.end(),0);
+int nagg(N);
+const csr* A=&_A[k];
+csr B; //aggregated matrix of the previous pass
+for(int pass=0;pass<3 && nagg*_ps.get_aggregation_ratio()>N;pass++)
+{
+	avector<int> match(&_pool);
+	int np=pairwise_matching(*A,match,pass==0);
+	if(np==nagg) //no pair is accepted anymore
+		break;
+	for(int i=0;i<N;i++)
+		if(agg[i]>=0)
+			agg[i]=match[agg[i]];
+	if(pass<2 && np*_ps.get_aggregation_ratio()>N) //pairs are aggregated again on the matrix of aggregates P^T*A*P
+	{
+		csr P(nagg,np);
+		int* pptr=P.outerIndexPtr();
+		for(int a=0;a<nagg;a++)
+			pptr[a+1]=pptr[a]+(match[a]>=0);
+		P.resizeNonZeros(pptr[nagg]);
+		for(int a=0;a<nagg;a++)
+		{
+			if(match[a]>=0)
+			{
+				P.innerIndexPtr()[pptr[a]]=match[a];
+				P.valuePtr()[pptr[a]]=1;
+			}
 		}
+		csr Ac;
+		galerkin_product(*A,P,Ac);
+		B.swap(Ac);
+		A=&B;
 	}
+	nagg=np;
 }
+const int* ptr=_A[k].outerIndexPtr();
+for(int i=0;i<N;i++) //only isolated points may be left out of aggregates
+	if(agg[i]<0 && ptr[i+1]-ptr[i]>1)
+		throw logic_error("Connected point left out of aggregates.");
+return nagg;
+}
+
+int setup::MIS_aggregation(const strength& G, avector<int>& agg)
+{
+int N=G.size();
+avector<Real> w(N,0,&_pool);
+avector<int> state(N,0,&_pool),next(N,0,&_pool); //state of points: 2 root, 1 undecided, 0 out of the independent set, -1 not aggregated
+avector<int> m1(N,0,&_pool),m2(N,0,&_pool); //largest point within distance 1 and 2
 
-I.setFromTriplets(elements.begin(), elements.end());
+auto larger=[&](const int& a, const int& b) //order of points by state, weight and index
+{
+	if(state[a]!=state[b])
+		return state[a]>state[b];
+	if(w[a]!=w[b])
+		return w[a]>w[b];
+	return a>b;
+};
+
+#pragma omp parallel for schedule(static)
+for(int i=0;i<N;i++) //points with no strong connection are not aggregated
+{
+	w[i]=random_weight(_ps.get_seed(),i);
+	bool strong(0);
+	neighbours(G,i,[&](const int&){strong=1;});
+	state[i]=strong ? 1 : -1;
 }
 
-vector<Real> setup::element_set(const SpMat& A, sets& B, const int& c)
+int undecided(1);
+while(undecided>0) //distance-2 independent set: an undecided point is a root if it is the largest within distance 2, out if a root is within distance 2
 {
-vector<Real> eval;
-size_t N=B.cardinality();
-	for(size_t i=0;i<N;i++)
+	undecided=0;
+	#pragma omp parallel
 	{
-		if(A.coeff(c,B[i])!=0)
+		#pragma omp for schedule(static)
+		for(int i=0;i<N;i++)
 		{
-			eval.push_back(A.coeff(c,B[i]));
+			m1[i]=i;
+			neighbours(G,i,[&](const int& j){if(larger(j,m1[i])) m1[i]=j;});
 		}
+
+		#pragma omp for schedule(static)
+		for(int i=0;i<N;i++)
+		{
+			m2[i]=m1[i];
+			neighbours(G,i,[&](const int& j){if(larger(m1[j],m2[i])) m2[i]=m1[j];});
+		}
+
+		#pragma omp for schedule(static) reduction(+:undecided)
+		for(int i=0;i<N;i++)
+		{
+			next[i]=state[i];
+			if(state[i]==1)
+			{
+				if(m2[i]==i)
+					next[i]=2;
+				else if(state[m2[i]]==2)
+					next[i]=0;
+				else
+					++undecided;
+			}
+		}
+	}
+	state.swap(next);
+}
+
+agg.assign(N,-1);
+int nagg(0);
+for(int i=0;i<N;i++) //roots are numbered in order
+	if(state[i]==2)
+		agg[i]=nagg++;
+
+for(int pass=0;pass<2;pass++) //points join the aggregate of a neighbour aggregated in the previous pass: roots at distance 1, then at distance 2
+{
+	avector<int> prev(agg);
+
+	#pragma omp parallel for schedule(static)
+	for(int i=0;i<N;i++)
+	{
+		if(prev[i]!=-1 || state[i]!=0)
+			continue;
+		neighbours(G,i,[&](const int& j){if(agg[i]==-1 && prev[j]!=-1) agg[i]=prev[j];});
+	}
+}
+
+for(int i=0;i<N;i++) //cleanup: points left with a strong connection join an aggregated neighbour, or start an aggregate
+{
+	if(agg[i]!=-1 || state[i]!=0)
+		continue;
+	neighbours(G,i,[&](const int& j){if(agg[i]==-1 && agg[j]!=-1) agg[i]=agg[j];});
+	if(agg[i]==-1)
+		agg[i]=nagg++;
+}
+return nagg;
+}
+
+void setup::unsmoothed_interpolation(const int& k, SpMat& I, const avector<int>& agg, const int& nagg)
+{
+int N=_A[k].rows();
+I.resize(N,nagg); //tentative interpolation operator, written directly in compressed storage
+int* ptr=I.outerIndexPtr();
+for(int i=0;i<N;i++)
+	ptr[i+1]=ptr[i]+(agg[i]>=0);
+I.resizeNonZeros(ptr[N]);
+int* col=I.innerIndexPtr();
+Real* val=I.valuePtr();
+
+#pragma omp parallel for schedule(static)
+for(int i=0;i<N;i++)
+{
+	if(agg[i]>=0)
+	{
+		col[ptr[i]]=agg[i];
+		val[ptr[i]]=1;
 	}
+}
+}
+
+void setup::GS_orth_interpolation(SpMat& I)
+{
+//orthogonalization is not needed because columns of I are orhogonal by construction
+
+//normalization
+Vec norm=Vec::Zero(I.cols());
+for(int k=0;k<I.outerSize();k++)
+	for(SpMat::InnerIterator it(I,k); it; ++it)
+		norm[it.col()]+=it.value()*it.value();
+norm=norm.cwiseSqrt();
+for(int k=0;k<I.outerSize();k++)
+	for(SpMat::InnerIterator it(I,k); it; ++it)
+		it.valueRef()/=norm[it.col()];
+}
+
+void setup::smoothed_interpolation(const int& k, SpMat& I)
+{
+const csr& A=_A[k];
+int N=A.rows();
+int nc=I.cols();
+const int* aptr=A.outerIndexPtr();
+const int* acol=A.innerIndexPtr();
+const Real* aval=A.valuePtr();
+const int* tptr=I.outerIndexPtr();
+const int* tcol=I.innerIndexPtr();
+const Real* tval=I.valuePtr();
+Real w=_ps.get_omega();
+if(w==0) //the spectral radius is estimated only when omega is not given
+{
+	Real rho=spectral_radius(A);
+	if(k==0)
+		_rho=rho;
+	w=4/(3*rho);
+}
+
+SpMat P(N,nc); //smoothing step P=(Id-w*D^-1*A)*I, row i is I(i,:)-w/A(i,i)*sum of A(i,k)*I(k,:)
+int* ptr=P.outerIndexPtr();
+for(int pass=0;pass<2;pass++)
+{
+	#pragma omp parallel
+	{
+		avector<int> marker(nc,-1,&_pool); //workspaces of each thread
+		avector<Real> acc(nc,0,&_pool);
+		avector<int> list(&_pool);
 
-return eval;
+		#pragma omp for schedule(dynamic,256)
+		for(int i=0;i<N;i++)
+		{
+			list.clear();
+			Real d(0);
+			auto scatter=[&](const int& k, const Real& s) //adds s*I(k,:) to the row
+			{
+				for(int q=tptr[k];q<tptr[k+1];q++)
+				{
+					int c=tcol[q];
+					if(marker[c]!=i)
+					{
+						marker[c]=i;
+						acc[c]=0;
+						list.push_back(c);
+					}
+					acc[c]+=s*tval[q];
+				}
+			};
+			for(int a=aptr[i];a<aptr[i+1];a++)
+				if(acol[a]==i)
+					d=aval[a];
+			scatter(i,1);
+			for(int a=aptr[i];a<aptr[i+1];a++)
+				scatter(acol[a],-w*aval[a]/d);
+			if(pass==0)
+				ptr[i+1]=list.size();
+			else
+			{
+				sort(list.begin(),list.end());
+				for(size_t q=0;q<list.size();q++)
+				{
+					P.innerIndexPtr()[ptr[i]+q]=list[q];
+					P.valuePtr()[ptr[i]+q]=acc[list[q]];
+				}
+			}
+		}
+	}
+	if(pass==0)
+	{
+		for(int i=0;i<N;i++)
+			ptr[i+1]+=ptr[i];
+		P.resizeNonZeros(ptr[N]);
+	}
+}
+track(matrix_bytes(I)+matrix_bytes(P));
+I.swap(P);
 }
 
+int setup::maxrow_pos(const csr& A, avector<int>& pos, avector<Real>& val)
+{
+int dim=A.rows();
+const int* ptr=A.outerIndexPtr();
+const int* col=A.innerIndexPtr();
+const Real* v=A.valuePtr();
+pos.assign(dim,-1);
+val.assign(dim,0);
+int isolated(0);
+
+#pragma omp parallel for schedule(static) reduction(+:isolated)
+for(int i=0;i<dim;i++)
+{
+	Real m(0);
+	for(int k=ptr[i];k<ptr[i+1];k++) //first maximum off-diagonal value of the row
+	{
+		if(col[k]!=i && abs(v[k])>m)
+		{
+			m=abs(v[k]);
+			pos[i]=col[k];
+			val[i]=v[k];
+		}
+	}
+	isolated+=(pos[i]==-1);
+}
+return isolated;
+}
@@ -0,0 +1,95 @@
+/**
+* @file   strength.cpp
+* @author Laura Melas <laura.melas@mail.polimi.it>
+* @date   2017
+*
+* This file is part of project "AMG Methods".
+*
+* @brief AMG methods for conforming and discontinuous Galerkin finite element discretizations of the Poisson problem.
+*
+*/
+
+#include "strength.h"
+
+strength::strength(const csr& A, const Real& theta, const bool& symmetric, arena* pool) : _mask(pool), _tptr(pool), _tind(pool)
+{
+_n=A.rows();
+_ptr=A.outerIndexPtr();
+_col=A.innerIndexPtr();
+const Real* val=A.valuePtr();
+_mask.assign(A.nonZeros(),0);
+
+avector<Real> maxcol(pool);
+if(!symmetric) //column maxima need a sweep of their own
+{
+	maxcol.assign(A.cols(),0);
+	for(int i=0;i<_n;i++)
+		for(int k=_ptr[i];k<_ptr[i+1];k++)
+			if(_col[k]!=i)
+				maxcol[_col[k]]=max(maxcol[_col[k]],abs(val[k]));
+}
+
+#pragma omp parallel for schedule(static)
+for(int i=0;i<_n;i++) //definition of strong dependence, weak and strong influence connections
+{
+	Real maxrow(0);
+	for(int k=_ptr[i];k<_ptr[i+1];k++)
+		if(_col[k]!=i)
+			maxrow=max(maxrow,abs(val[k]));
+	for(int k=_ptr[i];k<_ptr[i+1];k++)
+	{
+		if(_col[k]!=i)
+		{
+			_mask[k]=(abs(val[k])>=theta*maxrow) ? 1 : 2;
+			if(!symmetric && abs(val[k])>=theta*maxcol[_col[k]])
+				_mask[k]|=4;
+		}
+	}
+}
+
+_tptr.assign(_n+1,0);
+if(symmetric) //St is the transpose of S, built by counting sort
+{
+	for(int k=0;k<A.nonZeros();k++)
+		if(_mask[k] & 1)
+			++_tptr[_col[k]+1];
+	for(int i=0;i<_n;i++)
+		_tptr[i+1]+=_tptr[i];
+	_tind.resize(_tptr[_n]);
+	avector<int> next(_tptr.begin(),_tptr.end()-1,pool);
+	for(int i=0;i<_n;i++)
+		for(int k=_ptr[i];k<_ptr[i+1];k++)
+			if(_mask[k] & 1)
+				_tind[next[_col[k]]++]=i;
+}
+else //St is read row-wise from the mask
+{
+	for(int i=0;i<_n;i++)
+		for(int k=_ptr[i];k<_ptr[i+1];k++)
+			if(_mask[k] & 4)
+				++_tptr[i+1];
+	for(int i=0;i<_n;i++)
+		_tptr[i+1]+=_tptr[i];
+	_tind.resize(_tptr[_n]);
+	for(int i=0;i<_n;i++)
+	{
+		int next=_tptr[i];
+		for(int k=_ptr[i];k<_ptr[i+1];k++)
+			if(_mask[k] & 4)
+				_tind[next++]=_col[k];
+	}
+}
+}
+
+size_t strength::bytes() const
+{
+return _mask.capacity()+(_tptr.capacity()+_tind.capacity())*sizeof(int);
+}
+
+bool strength::isSymmetric(const SpMat& A)
+{
+if(A.rows()!=A.cols())
+	return 0;
+SpMat At=A.transpose();
+return (A-At).norm()<=1e-12*A.norm();
+}
@@ -70,8 +70,27 @@ if(lltOfA.info() == NumericalIssue)
 
 const Real theta=config("theta",0.25);
 const int nlevel=config("nlevel",2)-1;
+const string coarsening=config("coarsening","RS");
+const int seed=config("seed",0);
+const Real trunc_factor=config("trunc_factor",0.);
+const int max_elements=config("max_elements",0);
+const int aggressive_levels=config("aggressive_levels",0);
+const int max_coarse_size=config("max_coarse_size",0);
+const Real max_coarse_ratio=config("max_coarse_ratio",1.);
+const int half_storage=config("half_storage",0);
+const Real omega=config("omega",0.);
+const string hierarchy=config("hierarchy","classical");
+const string aggregation=config("aggregation","standard");
+const Real aggregation_ratio=config("aggregation_ratio",8.);
+const string aggregation_DG=config("aggregation_DG","pairwise");
+const Real theta_DG=config("theta_DG",1.);
+
+if(theta<=0 || theta>1 || nlevel<1 || seed<0 || trunc_factor<0 || trunc_factor>=1 || max_elements<0 || aggressive_levels<0 || max_coarse_size<0 || max_coarse_ratio<=0 || max_coarse_ratio>1 || half_storage<0 || half_storage>1 || omega<0 || aggregation_ratio<=1 || theta_DG<=0 || theta_DG>1)
+{
+	throw invalid_argument("Received invalid argument: check setup parameters.");
+}
 
-if(theta<=0 || theta>1 || nlevel<1)
+if((coarsening!="RS" && coarsening!="PMIS" && coarsening!="HMIS") || (hierarchy!="classical" && hierarchy!="SA") || (aggregation!="standard" && aggregation!="matching" && aggregation!="MIS") || (aggregation_DG!="pairwise" && aggregation_DG!="MIS"))
 {
 	throw invalid_argument("Received invalid argument: check setup parameters.");
 }
@@ -104,7 +123,7 @@ if(tol<0 || nmaxiter<0)
 }
 
 
-parameter_setup ps(nlevel,theta);
+parameter_setup ps(nlevel,theta,coarsening,seed,trunc_factor,max_elements,aggressive_levels,max_coarse_size,max_coarse_ratio,half_storage,omega,hierarchy,aggregation,aggregation_ratio,aggregation_DG,theta_DG);
 parameter_cycle pc(nlevel,nu1,nu2,mu);
 parameter_method pm(tol,nmaxiter);
 
@@ -164,7 +183,7 @@ else
 * Print output.
 */
 
-output O(testname,inputA,inputf,fem,multigrid,M.get_iter(),M.get_rho(),M.get_flag(),ps,pc,pm);
+output O(testname,inputA,inputf,fem,multigrid,M.get_iter(),M.get_rho(),M.get_flag(),S->get_nlevel()+1,S->operator_complexity(),S->hierarchy_bytes(),S->peak_bytes(),S->get_spectral_radius(),ps,pc,pm);
 
 if(print=="file")
 {